@@ -0,0 +1,258 @@
+/**
+ * @file ST7567_Animation.cpp
+ * @brief ST7567 增量压缩动画流式播放器实现
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#include "ST7567_Animation.h"
+
+/**
+ * @brief 构造函数
+ * @param lcd 显示屏驱动
+ */
+ST7567_AnimPlayer::ST7567_AnimPlayer(ST7567_LCD &lcd)
+    : _lcd(lcd), _bufferPos(0), _bufferLen(0), _frameCount(0), _frame(0), _delay(0),
+      _loopOffset(0), _due(0), _open(false), _loop(true)
+{
+}
+
+/**
+ * @brief 析构函数
+ */
+ST7567_AnimPlayer::~ST7567_AnimPlayer()
+{
+    close();
+}
+
+/**
+ * @brief 打开动画文件并校验文件头
+ */
+bool ST7567_AnimPlayer::open(fs::FS &fs, const char *path)
+{
+    close();
+    if (_lcd.isPageMode())
+        return false;
+
+    _file = fs.open(path, "r");
+    if (!_file)
+        return false;
+
+    _bufferPos = 0;
+    _bufferLen = 0;
+
+    uint8_t header[HEADER_SIZE];
+    if (!readBytes(header, HEADER_SIZE) || memcmp(header, "S7AN", 4) != 0 || header[4] != VERSION ||
+        header[5] != ST7567_LCD::PAGE_COUNT || (header[6] | (header[7] << 8)) != ST7567_LCD::LCD_WIDTH)
+    {
+        _file.close();
+        return false;
+    }
+
+    _frameCount = header[8] | (header[9] << 8);
+    _loopOffset = (uint32_t)header[12] | ((uint32_t)header[13] << 8) | ((uint32_t)header[14] << 16) |
+                  ((uint32_t)header[15] << 24);
+    _open = true;
+
+    rewind();
+    _due = millis();
+    return true;
+}
+
+/**
+ * @brief 关闭文件
+ */
+void ST7567_AnimPlayer::close()
+{
+    if (_open)
+    {
+        _file.close();
+        _open = false;
+    }
+}
+
+/**
+ * @brief 回到第0帧
+ *
+ * 第0帧是相对全黑画面的增量，帧缓冲区先清零；整屏标记为脏
+ */
+void ST7567_AnimPlayer::rewind()
+{
+    if (!_open)
+        return;
+
+    memset(_lcd.getFrameBuffer(), 0, ST7567_LCD::FRAME_SIZE);
+    _lcd.markAllDirty();
+    seek(HEADER_SIZE);
+    _frame = 0;
+}
+
+/**
+ * @brief 按帧时间播放
+ */
+bool ST7567_AnimPlayer::update()
+{
+    if (!_open)
+        return false;
+
+    uint32_t now = millis();
+    if ((int32_t)(now - _due) < 0)
+        return false;
+
+    if (!nextFrame())
+        return false;
+
+    _due += _delay;
+    if ((int32_t)(now - _due) >= 0)
+    {
+        _due = now + _delay;
+    }
+    return true;
+}
+
+/**
+ * @brief 解码下一帧
+ *
+ * 最后一帧之后：有循环帧时解码循环帧（回到第0帧的画面）并跳到第1帧，
+ * 否则清空帧缓冲区从第0帧重新开始
+ */
+bool ST7567_AnimPlayer::nextFrame(bool flush)
+{
+    if (!_open || _lcd.isPageMode())
+        return false;
+
+    bool wrap = false;
+    if (_frame >= _frameCount)
+    {
+        if (!_loop || _frameCount == 0)
+            return false;
+        if (_loopOffset == 0)
+            rewind();
+        else
+            wrap = true;
+    }
+
+    uint8_t record[3];
+    if (!readBytes(record, sizeof(record)))
+    {
+        close();
+        return false;
+    }
+    _delay = record[0] | (record[1] << 8);
+
+    for (uint8_t page = 0; page < ST7567_LCD::PAGE_COUNT; page++)
+    {
+        if ((record[2] & (1 << page)) && !decodePage(page))
+        {
+            close();
+            return false;
+        }
+    }
+
+    if (wrap)
+    {
+        seek(_loopOffset);
+        _frame = 1;
+    }
+    else
+    {
+        _frame++;
+    }
+
+    if (flush)
+    {
+        _lcd.displayDirty();
+    }
+    return true;
+}
+
+/**
+ * @brief 解码一页的增量
+ *
+ * 跳过段不修改帧缓冲区；增量段逐字节异或，并记录该页被修改的列区间
+ */
+bool ST7567_AnimPlayer::decodePage(uint8_t page)
+{
+    uint8_t *row = _lcd.getFrameBuffer() + page * ST7567_LCD::LCD_WIDTH;
+    uint8_t x0 = 0xFF;
+    uint8_t x1 = 0;
+    uint16_t x = 0;
+
+    while (x < ST7567_LCD::LCD_WIDTH)
+    {
+        int token = readByte();
+        if (token < 0)
+            return false;
+
+        if (token < 0x80)
+        {
+            x += token + 1;
+            continue;
+        }
+
+        uint8_t n = token - 0x7F;
+        if (x + n > ST7567_LCD::LCD_WIDTH)
+            return false;
+
+        if (x < x0)
+            x0 = x;
+        x1 = x + n - 1;
+        while (n-- > 0)
+        {
+            int delta = readByte();
+            if (delta < 0)
+                return false;
+            row[x++] ^= (uint8_t)delta;
+        }
+    }
+
+    if (x != ST7567_LCD::LCD_WIDTH)
+        return false;
+
+    if (x0 <= x1)
+    {
+        _lcd.markDirtyRegion(x0, page * 8, x1 - x0 + 1, 8);
+    }
+    return true;
+}
+
+/**
+ * @brief 从读取缓冲区取一个字节（缓冲区空时从文件读取下一块）
+ */
+int ST7567_AnimPlayer::readByte()
+{
+    if (_bufferPos >= _bufferLen)
+    {
+        _bufferLen = _file.read(_buffer, BUFFER_SIZE);
+        _bufferPos = 0;
+        if (_bufferLen == 0)
+            return -1;
+    }
+    return _buffer[_bufferPos++];
+}
+
+/**
+ * @brief 从读取缓冲区取n个字节
+ */
+bool ST7567_AnimPlayer::readBytes(uint8_t *out, uint16_t n)
+{
+    for (uint16_t i = 0; i < n; i++)
+    {
+        int c = readByte();
+        if (c < 0)
+            return false;
+        out[i] = (uint8_t)c;
+    }
+    return true;
+}
+
+/**
+ * @brief 定位到文件偏移并清空读取缓冲区
+ */
+bool ST7567_AnimPlayer::seek(uint32_t offset)
+{
+    _bufferPos = 0;
+    _bufferLen = 0;
+    return _file.seek(offset);
+}
@@ -0,0 +1,164 @@
+/**
+ * @file ST7567_Animation.h
+ * @brief ST7567 增量压缩动画流式播放器
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 从LittleFS/SPIFFS等文件系统逐帧读取动画，帧数据为与上一帧的逐页XOR增量：
+ * - 只读取和解码有变化的页，增量原地异或到帧缓冲区
+ * - 每页登记实际变化的列区间，displayDirty()只发送这些区间
+ * - 读取使用64字节的小缓冲区，文件不整体载入内存
+ *
+ * 文件格式（小端序，由tools/st7567_anim_encode.py生成）：
+ * @code
+ * 文件头（16字节）
+ *   char     magic[4]    "S7AN"
+ *   uint8_t  version     1
+ *   uint8_t  pages       8
+ *   uint16_t width       128
+ *   uint16_t frameCount  帧数（不含循环帧）
+ *   uint16_t reserved    0
+ *   uint32_t loopOffset  第1帧的文件偏移；0表示没有循环帧
+ * 帧记录（frameCount个，有loopOffset时末尾再跟一个从最后一帧回到第0帧的循环帧）
+ *   uint16_t delayMs     本帧显示时间
+ *   uint8_t  pageMask    有变化的页（bit n对应第n页）
+ *   每个变化页的128列依次编码为若干段：
+ *     0x00-0x7F  跳过 n+1 列（增量为0）
+ *     0x80-0xFF  后跟 n-0x7F 个增量字节，与帧缓冲区异或
+ * @endcode
+ * 第0帧是相对全黑画面的增量。
+ *
+ * 使用示例：
+ * @code
+ * #include <LittleFS.h>
+ * ST7567_AnimPlayer player(lcd);
+ *
+ * void setup() {
+ *     lcd.begin();
+ *     LittleFS.begin();
+ *     player.open(LittleFS, "/boot.anim");
+ * }
+ *
+ * void loop() {
+ *     player.update(); // 到时间时解码下一帧并发送变化的列
+ * }
+ * @endcode
+ *
+ * @note 播放期间帧缓冲区保存着上一帧，不要在上面绘制（增量会叠加到绘制的内容上）。
+ * 坐标为物理坐标，不受setRotation()影响；分页渲染模式下不可用
+ */
+
+#ifndef __ST7567_ANIMATION_H
+#define __ST7567_ANIMATION_H
+
+#include <FS.h>
+#include "ST7567_LCD.h"
+
+class ST7567_AnimPlayer
+{
+public:
+    static const uint8_t HEADER_SIZE = 16;  ///< 文件头字节数
+    static const uint8_t VERSION = 1;       ///< 格式版本
+    static const uint8_t BUFFER_SIZE = 64;  ///< 读取缓冲区字节数
+
+    /**
+     * @brief 构造函数
+     * @param lcd 显示屏驱动
+     */
+    ST7567_AnimPlayer(ST7567_LCD &lcd);
+
+    /**
+     * @brief 析构函数 - 关闭文件
+     */
+    ~ST7567_AnimPlayer();
+
+    /**
+     * @brief 打开动画文件
+     * @param fs   文件系统（LittleFS、SPIFFS、SD等）
+     * @param path 文件路径
+     * @return true:文件头有效
+     *
+     * 清空帧缓冲区，下一次update()立即显示第0帧
+     */
+    bool open(fs::FS &fs, const char *path);
+
+    /**
+     * @brief 关闭文件（帧缓冲区保留最后显示的画面）
+     */
+    void close();
+
+    /**
+     * @brief 是否已打开
+     */
+    bool isOpen() const { return _open; }
+
+    /**
+     * @brief 设置是否循环播放
+     * @param loop true:播放到最后一帧后回到第0帧
+     */
+    void setLoop(bool loop) { _loop = loop; }
+
+    /**
+     * @brief 按帧时间播放
+     * @return true:本次调用显示了新的一帧
+     *
+     * 在loop()中尽量频繁地调用；帧时间按计划累加，落后超过一帧时重新对齐
+     */
+    bool update();
+
+    /**
+     * @brief 立即解码下一帧
+     * @param flush true:解码后调用displayDirty()发送
+     * @return false:已播放完毕（不循环）或文件损坏
+     */
+    bool nextFrame(bool flush = true);
+
+    /**
+     * @brief 回到第0帧（清空帧缓冲区）
+     */
+    void rewind();
+
+    uint16_t getFrameCount() const { return _frameCount; } ///< 帧数
+    uint16_t getFrameIndex() const { return _frame; }      ///< 下一个要显示的帧
+    uint16_t getFrameDelay() const { return _delay; }      ///< 刚显示的帧的显示时间（毫秒）
+
+private:
+    /**
+     * @brief 从读取缓冲区取一个字节
+     * @return 0-255；文件结束时返回-1
+     */
+    int readByte();
+
+    /**
+     * @brief 从读取缓冲区取n个字节
+     * @return true:读取完整
+     */
+    bool readBytes(uint8_t *out, uint16_t n);
+
+    /**
+     * @brief 定位到文件偏移并清空读取缓冲区
+     */
+    bool seek(uint32_t offset);
+
+    /**
+     * @brief 解码一页的增量并登记变化的列
+     * @return false:数据损坏
+     */
+    bool decodePage(uint8_t page);
+
+    ST7567_LCD &_lcd;                 ///< 显示屏驱动
+    fs::File _file;                   ///< 动画文件
+    uint8_t _buffer[BUFFER_SIZE];     ///< 读取缓冲区
+    uint8_t _bufferPos;               ///< 缓冲区读取位置
+    uint8_t _bufferLen;               ///< 缓冲区有效字节数
+    uint16_t _frameCount;             ///< 帧数
+    uint16_t _frame;                  ///< 下一个要解码的帧
+    uint16_t _delay;                  ///< 当前帧显示时间
+    uint32_t _loopOffset;             ///< 第1帧的文件偏移（0:没有循环帧）
+    uint32_t _due;                    ///< 下一帧的显示时间（millis）
+    bool _open;                       ///< 已打开
+    bool _loop;                       ///< 循环播放
+};
+
+#endif // __ST7567_ANIMATION_H
@@ -0,0 +1,265 @@
+/**
+ * @file ST7567_Blit.cpp
+ * @brief ST7567 页格式位块传送实现
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#include "ST7567_Blit.h"
+#include "ST7567_PageKernels.h"
+
+/**
+ * @brief 全零行：源页超出缓冲区时代替该页（对应的行都在目标掩码之外）
+ */
+static const uint8_t ZERO_ROW[ST7567_LCD::LCD_WIDTH] = {0};
+
+/**
+ * @brief 单字节光栅运算（ROP为编译期常量，switch被折叠）
+ */
+template <uint8_t ROP>
+static inline uint8_t rasterOp(uint8_t d, uint8_t s)
+{
+    switch (ROP)
+    {
+    case ST7567_Blitter::ROP_OR:
+        return d | s;
+    case ST7567_Blitter::ROP_AND:
+        return d & s;
+    case ST7567_Blitter::ROP_XOR:
+        return d ^ s;
+    case ST7567_Blitter::ROP_NOT_SRC:
+        return ~s;
+    case ST7567_Blitter::ROP_AND_NOT:
+        return d & ~s;
+    default:
+        return s;
+    }
+}
+
+/**
+ * @brief 传送一页中的一段列
+ * @param d    目标页第一列
+ * @param lo   对齐后覆盖目标页顶行的源页（同列）
+ * @param hi   lo的下一页
+ * @param w    列数
+ * @param off  目标页顶行在lo中的位偏移（0-7）
+ * @param mask 目标页中位于矩形内的行
+ * @param reverse true:从右向左处理（同一缓冲区内右移）
+ */
+template <uint8_t ROP>
+static void blitSpan(uint8_t *d, const uint8_t *lo, const uint8_t *hi, int16_t w, uint8_t off, uint8_t mask,
+                     bool reverse)
+{
+    int16_t i = reverse ? w - 1 : 0;
+    int16_t step = reverse ? -1 : 1;
+
+    if (off == 0)
+    {
+        for (int16_t n = 0; n < w; n++, i += step)
+        {
+            d[i] = (d[i] & ~mask) | (rasterOp<ROP>(d[i], lo[i]) & mask);
+        }
+        return;
+    }
+
+    for (int16_t n = 0; n < w; n++, i += step)
+    {
+        uint8_t s = (uint8_t)((lo[i] | (hi[i] << 8)) >> off);
+        d[i] = (d[i] & ~mask) | (rasterOp<ROP>(d[i], s) & mask);
+    }
+}
+
+/**
+ * @brief 传送内核（矩形已裁剪）
+ *
+ * 目标第r行取自源第r - shift行。同一缓冲区时：下移从最后一页向上处理、上移从第一页向下处理，
+ * 每页读取的源页要么已经处理完、要么是本页（同列先读后写）；列方向按水平位移选择
+ */
+template <uint8_t ROP>
+static void blitPages(uint8_t *dst, int16_t dx, int16_t dy, const uint8_t *src, int16_t sx, int16_t sy,
+                      int16_t w, int16_t h)
+{
+    const int16_t W = ST7567_LCD::LCD_WIDTH;
+    int16_t shift = dy - sy;
+    int16_t page0 = dy >> 3;
+    int16_t page1 = (dy + h - 1) >> 3;
+    bool reverse = dx > sx;
+
+    for (int16_t n = 0; n <= page1 - page0; n++)
+    {
+        int16_t page = (shift > 0) ? page1 - n : page0 + n;
+
+        uint8_t mask = 0xFF;
+        if (page == page0)
+            mask &= (uint8_t)(0xFF << (dy & 7));
+        if (page == page1)
+            mask &= (uint8_t)(0xFF >> (7 - ((dy + h - 1) & 7)));
+
+        int16_t top = page * 8 - shift; // 目标页顶行对应的源行
+        int16_t srcPage = st7567_floorPage(top);
+        uint8_t off = top - srcPage * 8;
+        const uint8_t *lo = ZERO_ROW;
+        const uint8_t *hi = ZERO_ROW;
+        if (srcPage >= 0 && srcPage < ST7567_LCD::PAGE_COUNT)
+            lo = &src[srcPage * W];
+        if (srcPage + 1 >= 0 && srcPage + 1 < ST7567_LCD::PAGE_COUNT)
+            hi = &src[(srcPage + 1) * W];
+        uint8_t *d = &dst[page * W + dx];
+
+        if (ROP == ST7567_Blitter::ROP_COPY && off == 0 && mask == 0xFF)
+        {
+            memmove(d, lo + sx, w);
+            continue;
+        }
+        blitSpan<ROP>(d, lo + sx, hi + sx, w, off, mask, reverse);
+    }
+}
+
+/**
+ * @brief 同时裁剪源矩形和目标矩形
+ */
+bool ST7567_Blitter::clip(int16_t &dx, int16_t &dy, int16_t &sx, int16_t &sy, int16_t &w, int16_t &h)
+{
+    const int16_t W = ST7567_LCD::LCD_WIDTH;
+    const int16_t H = ST7567_LCD::LCD_HEIGHT;
+
+    if (sx < 0)
+    {
+        w += sx;
+        dx -= sx;
+        sx = 0;
+    }
+    if (dx < 0)
+    {
+        w += dx;
+        sx -= dx;
+        dx = 0;
+    }
+    if (sy < 0)
+    {
+        h += sy;
+        dy -= sy;
+        sy = 0;
+    }
+    if (dy < 0)
+    {
+        h += dy;
+        sy -= dy;
+        dy = 0;
+    }
+    if (w > W - sx)
+        w = W - sx;
+    if (w > W - dx)
+        w = W - dx;
+    if (h > H - sy)
+        h = H - sy;
+    if (h > H - dy)
+        h = H - dy;
+
+    return w > 0 && h > 0;
+}
+
+/**
+ * @brief 按运算分派到模板内核
+ */
+void ST7567_Blitter::blitClipped(uint8_t *dst, int16_t dx, int16_t dy, const uint8_t *src, int16_t sx, int16_t sy,
+                                 int16_t w, int16_t h, RasterOp rop)
+{
+    switch (rop)
+    {
+    case ROP_OR:
+        blitPages<ROP_OR>(dst, dx, dy, src, sx, sy, w, h);
+        break;
+    case ROP_AND:
+        blitPages<ROP_AND>(dst, dx, dy, src, sx, sy, w, h);
+        break;
+    case ROP_XOR:
+        blitPages<ROP_XOR>(dst, dx, dy, src, sx, sy, w, h);
+        break;
+    case ROP_NOT_SRC:
+        blitPages<ROP_NOT_SRC>(dst, dx, dy, src, sx, sy, w, h);
+        break;
+    case ROP_AND_NOT:
+        blitPages<ROP_AND_NOT>(dst, dx, dy, src, sx, sy, w, h);
+        break;
+    default:
+        blitPages<ROP_COPY>(dst, dx, dy, src, sx, sy, w, h);
+        break;
+    }
+}
+
+/**
+ * @brief 目标表面登记被修改的页
+ */
+void ST7567_Blitter::markSurface(ST7567_Surface &dst, int16_t dy, int16_t h)
+{
+    uint8_t page0 = dy >> 3;
+    uint8_t page1 = (dy + h - 1) >> 3;
+    dst.markDirtyPages((uint8_t)((0xFF << page0) & (0xFF >> (7 - page1))));
+}
+
+/**
+ * @brief 在两个页格式缓冲区之间传送
+ */
+bool ST7567_Blitter::blit(uint8_t *dst, int16_t dx, int16_t dy, const uint8_t *src, int16_t sx, int16_t sy,
+                          int16_t w, int16_t h, RasterOp rop)
+{
+    if (dst == nullptr || src == nullptr || !clip(dx, dy, sx, sy, w, h))
+        return false;
+
+    blitClipped(dst, dx, dy, src, sx, sy, w, h, rop);
+    return true;
+}
+
+/**
+ * @brief 表面 → 驱动帧缓冲区
+ */
+void ST7567_Blitter::blit(ST7567_LCD &dst, int16_t dx, int16_t dy, const ST7567_Surface &src, int16_t sx,
+                          int16_t sy, int16_t w, int16_t h, RasterOp rop)
+{
+    if (dst.isPageMode() || !clip(dx, dy, sx, sy, w, h))
+        return;
+
+    blitClipped(dst.getFrameBuffer(), dx, dy, src.getBuffer(), sx, sy, w, h, rop);
+    dst.markDirtyRegion(dx, dy, w, h);
+}
+
+/**
+ * @brief 驱动帧缓冲区内传送
+ */
+void ST7567_Blitter::blit(ST7567_LCD &dst, int16_t dx, int16_t dy, ST7567_LCD &src, int16_t sx, int16_t sy,
+                          int16_t w, int16_t h, RasterOp rop)
+{
+    if (dst.isPageMode() || src.isPageMode() || !clip(dx, dy, sx, sy, w, h))
+        return;
+
+    blitClipped(dst.getFrameBuffer(), dx, dy, src.getFrameBuffer(), sx, sy, w, h, rop);
+    dst.markDirtyRegion(dx, dy, w, h);
+}
+
+/**
+ * @brief 驱动帧缓冲区 → 表面
+ */
+void ST7567_Blitter::blit(ST7567_Surface &dst, int16_t dx, int16_t dy, ST7567_LCD &src, int16_t sx, int16_t sy,
+                          int16_t w, int16_t h, RasterOp rop)
+{
+    if (src.isPageMode() || !clip(dx, dy, sx, sy, w, h))
+        return;
+
+    blitClipped(dst.getBuffer(), dx, dy, src.getFrameBuffer(), sx, sy, w, h, rop);
+    markSurface(dst, dy, h);
+}
+
+/**
+ * @brief 表面 → 表面
+ */
+void ST7567_Blitter::blit(ST7567_Surface &dst, int16_t dx, int16_t dy, const ST7567_Surface &src, int16_t sx,
+                          int16_t sy, int16_t w, int16_t h, RasterOp rop)
+{
+    if (!clip(dx, dy, sx, sy, w, h))
+        return;
+
+    blitClipped(dst.getBuffer(), dx, dy, src.getBuffer(), sx, sy, w, h, rop);
+    markSurface(dst, dy, h);
+}
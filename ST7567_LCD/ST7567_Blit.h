@@ -0,0 +1,122 @@
+/**
+ * @file ST7567_Blit.h
+ * @brief ST7567 页格式位块传送（BitBlt）
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 在页格式缓冲区（驱动帧缓冲区、任意数量的ST7567_Surface）之间按矩形传送像素，
+ * 并与目标做光栅运算：
+ * - 运算：COPY、OR、AND、XOR、NOT_SRC、AND_NOT
+ * - 源和目标的行偏移不是8的倍数时，把相邻两个源页拼成16位后移位对齐，每列每页一次读取
+ * - 目标页只有部分行在矩形内时，按页掩码混合，矩形外的行不变
+ * - 源和目标为同一缓冲区且区域重叠时（窗口移动、滚动），按位移方向选择页和列的处理顺序，
+ *   源数据在被覆盖前读取
+ * - 行对齐且整页覆盖的COPY直接memmove
+ *
+ * 优化特性：
+ * - 运算在模板实例中展开，内循环没有分支
+ * - 超出缓冲区的源页指向全零行，内循环不做边界检查
+ * - 目标为驱动时只登记传送矩形的脏区，目标为表面时登记修改的页
+ *
+ * 使用示例：
+ * @code
+ * ST7567_Surface icons;   // 图标表
+ * ST7567_Surface popup;   // 弹出窗口
+ *
+ * // 图标打到屏幕上（点亮的像素叠加）
+ * ST7567_Blitter::blit(lcd, 100, 3, icons, 16, 0, 16, 16, ST7567_Blitter::ROP_OR);
+ * // 保存弹出窗口下面的内容，再把窗口复制上去
+ * ST7567_Blitter::blit(popup, 0, 0, lcd, 20, 12, 88, 40);
+ * // 窗口右移3像素、下移5像素（同一缓冲区内重叠传送）
+ * ST7567_Blitter::blit(lcd, 23, 17, lcd, 20, 12, 88, 40);
+ * lcd.displayDirty();
+ * @endcode
+ *
+ * @note 坐标为缓冲区物理坐标，不受setRotation()影响；驱动处于分页渲染模式时不传送
+ */
+
+#ifndef __ST7567_BLIT_H
+#define __ST7567_BLIT_H
+
+#include "ST7567_LCD.h"
+#include "ST7567_Surface.h"
+
+class ST7567_Blitter
+{
+public:
+    /**
+     * @brief 光栅运算（dst为目标原内容，src为源）
+     */
+    enum RasterOp
+    {
+        ROP_COPY,    ///< dst = src
+        ROP_OR,      ///< dst = dst | src
+        ROP_AND,     ///< dst = dst & src
+        ROP_XOR,     ///< dst = dst ^ src
+        ROP_NOT_SRC, ///< dst = ~src
+        ROP_AND_NOT  ///< dst = dst & ~src（源点亮的像素擦除目标）
+    };
+
+    /**
+     * @brief 在两个页格式缓冲区之间传送
+     * @param dst 目标缓冲区（FRAME_SIZE字节）
+     * @param dx  目标左上角X
+     * @param dy  目标左上角Y
+     * @param src 源缓冲区（FRAME_SIZE字节，可以与dst相同）
+     * @param sx  源左上角X
+     * @param sy  源左上角Y
+     * @param w   宽度
+     * @param h   高度
+     * @param rop 光栅运算
+     * @return true:裁剪后有像素被传送
+     *
+     * 源矩形和目标矩形同时裁剪到缓冲区范围内
+     */
+    static bool blit(uint8_t *dst, int16_t dx, int16_t dy, const uint8_t *src, int16_t sx, int16_t sy,
+                     int16_t w, int16_t h, RasterOp rop = ROP_COPY);
+
+    /**
+     * @brief 表面 → 驱动帧缓冲区（弹出窗口、图标）
+     */
+    static void blit(ST7567_LCD &dst, int16_t dx, int16_t dy, const ST7567_Surface &src, int16_t sx, int16_t sy,
+                     int16_t w, int16_t h, RasterOp rop = ROP_COPY);
+
+    /**
+     * @brief 驱动帧缓冲区内传送（窗口移动、局部滚动，可以重叠）
+     */
+    static void blit(ST7567_LCD &dst, int16_t dx, int16_t dy, ST7567_LCD &src, int16_t sx, int16_t sy,
+                     int16_t w, int16_t h, RasterOp rop = ROP_COPY);
+
+    /**
+     * @brief 驱动帧缓冲区 → 表面（保存弹出窗口下面的内容）
+     */
+    static void blit(ST7567_Surface &dst, int16_t dx, int16_t dy, ST7567_LCD &src, int16_t sx, int16_t sy,
+                     int16_t w, int16_t h, RasterOp rop = ROP_COPY);
+
+    /**
+     * @brief 表面 → 表面
+     */
+    static void blit(ST7567_Surface &dst, int16_t dx, int16_t dy, const ST7567_Surface &src, int16_t sx, int16_t sy,
+                     int16_t w, int16_t h, RasterOp rop = ROP_COPY);
+
+private:
+    /**
+     * @brief 同时裁剪源矩形和目标矩形
+     * @return true:裁剪后非空
+     */
+    static bool clip(int16_t &dx, int16_t &dy, int16_t &sx, int16_t &sy, int16_t &w, int16_t &h);
+
+    /**
+     * @brief 按运算分派到模板内核（矩形已裁剪）
+     */
+    static void blitClipped(uint8_t *dst, int16_t dx, int16_t dy, const uint8_t *src, int16_t sx, int16_t sy,
+                            int16_t w, int16_t h, RasterOp rop);
+
+    /**
+     * @brief 目标表面登记被修改的页
+     */
+    static void markSurface(ST7567_Surface &dst, int16_t dy, int16_t h);
+};
+
+#endif // __ST7567_BLIT_H
@@ -0,0 +1,206 @@
+/**
+ * @file ST7567_Compositor.cpp
+ * @brief ST7567 多图层合成器实现
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#include "ST7567_Compositor.h"
+#include "ST7567_PageKernels.h"
+
+/**
+ * @brief 构造函数
+ * @param lcd 合成目标显示屏
+ */
+ST7567_Compositor::ST7567_Compositor(ST7567_LCD &lcd)
+    : _lcd(lcd), _layerCount(0), _invalidPages(0xFF), _lastPages(0),
+      _lastTarget(nullptr), _prevTarget(nullptr)
+{
+}
+
+/**
+ * @brief 在最上层添加图层
+ * @return 图层序号，图层已满时返回-1
+ */
+int8_t ST7567_Compositor::addLayer(ST7567_Surface &surface, BlendOp op, ST7567_Surface *mask)
+{
+    if (_layerCount >= MAX_LAYERS)
+        return -1;
+
+    Layer &layer = _layers[_layerCount];
+    layer.surface = &surface;
+    layer.mask = mask;
+    layer.op = op;
+    layer.visible = true;
+    _invalidPages = 0xFF;
+    return _layerCount++;
+}
+
+/**
+ * @brief 移除所有图层
+ */
+void ST7567_Compositor::clearLayers()
+{
+    _layerCount = 0;
+    _invalidPages = 0xFF;
+}
+
+/**
+ * @brief 显示/隐藏图层（图层内容涉及的页全部需要重新合成）
+ */
+void ST7567_Compositor::setLayerVisible(uint8_t index, bool visible)
+{
+    if (index >= _layerCount || _layers[index].visible == visible)
+        return;
+    _layers[index].visible = visible;
+    _invalidPages = 0xFF;
+}
+
+/**
+ * @brief 修改图层混合方式
+ */
+void ST7567_Compositor::setLayerOp(uint8_t index, BlendOp op, ST7567_Surface *mask)
+{
+    if (index >= _layerCount)
+        return;
+    _layers[index].op = op;
+    _layers[index].mask = mask;
+    _invalidPages = 0xFF;
+}
+
+/**
+ * @brief 将一页图层数据混合到目标页
+ *
+ * 每页128字节 = 32个32位字，按字做位运算，比逐字节快约4倍
+ */
+void ST7567_Compositor::blendPage(uint8_t *dst, const uint8_t *src, const uint8_t *mask, BlendOp op)
+{
+    const uint8_t WORDS = ST7567_LCD::LCD_WIDTH / 4;
+    st7567_word_t *d = (st7567_word_t *)dst;
+    const st7567_word_t *s = (const st7567_word_t *)src;
+
+    if (op == BLEND_MASKED && mask == nullptr)
+        op = BLEND_OPAQUE;
+
+    switch (op)
+    {
+    case BLEND_OPAQUE:
+        memcpy(dst, src, ST7567_LCD::LCD_WIDTH);
+        break;
+    case BLEND_OR:
+        for (uint8_t i = 0; i < WORDS; i++)
+            d[i] |= s[i];
+        break;
+    case BLEND_AND_NOT:
+        for (uint8_t i = 0; i < WORDS; i++)
+            d[i] &= ~s[i];
+        break;
+    case BLEND_XOR:
+        for (uint8_t i = 0; i < WORDS; i++)
+            d[i] ^= s[i];
+        break;
+    case BLEND_MASKED:
+    {
+        const st7567_word_t *m = (const st7567_word_t *)mask;
+        for (uint8_t i = 0; i < WORDS; i++)
+            d[i] = (d[i] & ~m[i]) | (s[i] & m[i]);
+        break;
+    }
+    }
+}
+
+/**
+ * @brief 合成被修改的页到帧缓冲区
+ * @return 本次合成的页掩码
+ *
+ * 合成流程：
+ * 1. 收集所有可见图层及其掩码被修改的页
+ * 2. 目标缓冲区与上次不同（双缓冲交换）时，补上上一帧图层修改的页；从未合成过的缓冲区全部合成
+ * 3. 逐页：底层为不透明时直接复制，否则先清零，再自下而上混合各图层
+ * 4. 登记脏区，清除图层修改记录
+ */
+uint8_t ST7567_Compositor::compose()
+{
+    if (_lcd.isPageMode())
+        return 0;
+
+    uint8_t *target = _lcd.getFrameBuffer();
+    if (target == nullptr)
+        return 0;
+
+    uint8_t pages = _invalidPages;
+    for (uint8_t i = 0; i < _layerCount; i++)
+    {
+        const Layer &layer = _layers[i];
+        if (!layer.visible)
+            continue;
+        pages |= layer.surface->getDirtyPages();
+        if (layer.op == BLEND_MASKED && layer.mask != nullptr)
+            pages |= layer.mask->getDirtyPages();
+    }
+
+    // 双缓冲：后台缓冲区少了上一帧图层修改的页
+    uint8_t changed = pages;
+    if (target != _lastTarget)
+    {
+        pages |= (target == _prevTarget) ? _lastPages : 0xFF;
+        _prevTarget = _lastTarget;
+        _lastTarget = target;
+    }
+
+    if (pages != 0)
+    {
+        bool opaqueBase = _layerCount > 0 && _layers[0].visible &&
+                          (_layers[0].op == BLEND_OPAQUE ||
+                           (_layers[0].op == BLEND_MASKED && _layers[0].mask == nullptr));
+
+        for (uint8_t page = 0; page < ST7567_LCD::PAGE_COUNT; page++)
+        {
+            if (!(pages & (1 << page)))
+                continue;
+
+            uint16_t offset = page * ST7567_LCD::LCD_WIDTH;
+            uint8_t *dst = target + offset;
+            if (!opaqueBase)
+            {
+                memset(dst, 0x00, ST7567_LCD::LCD_WIDTH);
+            }
+
+            for (uint8_t i = 0; i < _layerCount; i++)
+            {
+                const Layer &layer = _layers[i];
+                if (!layer.visible)
+                    continue;
+                blendPage(dst, layer.surface->getBuffer() + offset,
+                          layer.mask != nullptr ? layer.mask->getBuffer() + offset : nullptr, layer.op);
+            }
+
+            _lcd.markDirtyRegion(0, page * 8, ST7567_LCD::LCD_WIDTH, 8);
+        }
+    }
+
+    for (uint8_t i = 0; i < _layerCount; i++)
+    {
+        _layers[i].surface->clearDirty();
+        if (_layers[i].mask != nullptr)
+            _layers[i].mask->clearDirty();
+    }
+    _invalidPages = 0;
+    _lastPages = changed;
+    return pages;
+}
+
+/**
+ * @brief 合成并刷新被修改的页
+ * @return 本次合成的页掩码
+ */
+uint8_t ST7567_Compositor::present()
+{
+    uint8_t pages = compose();
+    if (pages != 0)
+    {
+        _lcd.displayDirty();
+    }
+    return pages;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file ST7567_Compositor.h
+ * @brief ST7567 多图层合成器
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 将若干ST7567_Surface图层按顺序合成到驱动帧缓冲区，例如：
+ * - 第0层：静态背景（边框、标签），只绘制一次
+ * - 第1层：动态内容，只重绘变化的数值
+ * - 第2层：光标/弹出层，XOR或带掩码覆盖
+ *
+ * 优化特性：
+ * - 只重新合成有图层被修改的页（图层按页记录修改）
+ * - 合成内核按32位字处理，一页128字节为32个字
+ * - 底层为不透明图层时直接memcpy，不需要先清零
+ * - 双缓冲时自动补合成另一缓冲区缺少的页
+ *
+ * @note 双缓冲使用SWAP_CLEAR交换时后台缓冲区被清零，交换后需调用invalidate()
+ *
+ * 典型用法：
+ * @code
+ * ST7567_Surface background, content;
+ * ST7567_Compositor compositor(lcd);
+ * compositor.addLayer(background, ST7567_Compositor::BLEND_OPAQUE);
+ * compositor.addLayer(content, ST7567_Compositor::BLEND_OR);
+ * // 每帧
+ * content.fillRect(...); content.print(value);
+ * compositor.present();
+ * @endcode
+ */
+
+#ifndef __ST7567_COMPOSITOR_H
+#define __ST7567_COMPOSITOR_H
+
+#include "ST7567_LCD.h"
+#include "ST7567_Surface.h"
+
+class ST7567_Compositor
+{
+public:
+    /**
+     * @brief 图层混合方式（dst为下层合成结果，src为本层）
+     */
+    enum BlendOp
+    {
+        BLEND_OPAQUE,  ///< dst = src
+        BLEND_OR,      ///< dst = dst | src
+        BLEND_AND_NOT, ///< dst = dst & ~src（本层点亮的像素擦除下层）
+        BLEND_XOR,     ///< dst = dst ^ src
+        BLEND_MASKED   ///< dst = (dst & ~mask) | (src & mask)（无掩码图层时等同BLEND_OPAQUE）
+    };
+
+    static const uint8_t MAX_LAYERS = 4; ///< 最大图层数
+
+    /**
+     * @brief 构造函数
+     * @param lcd 合成目标显示屏
+     */
+    ST7567_Compositor(ST7567_LCD &lcd);
+
+    /**
+     * @brief 在最上层添加图层
+     * @param surface 图层表面
+     * @param op 混合方式
+     * @param mask 掩码表面（仅BLEND_MASKED使用，点亮的像素表示本层覆盖）
+     * @return 图层序号，图层已满时返回-1
+     */
+    int8_t addLayer(ST7567_Surface &surface, BlendOp op = BLEND_OR, ST7567_Surface *mask = nullptr);
+
+    /**
+     * @brief 移除所有图层
+     */
+    void clearLayers();
+
+    /**
+     * @brief 显示/隐藏图层
+     * @param index 图层序号
+     * @param visible 是否可见
+     */
+    void setLayerVisible(uint8_t index, bool visible);
+
+    /**
+     * @brief 修改图层混合方式
+     * @param index 图层序号
+     * @param op 混合方式
+     * @param mask 掩码表面
+     */
+    void setLayerOp(uint8_t index, BlendOp op, ST7567_Surface *mask = nullptr);
+
+    /**
+     * @brief 获取图层数
+     */
+    uint8_t getLayerCount() const { return _layerCount; }
+
+    /**
+     * @brief 下次合成时重新合成全部页
+     */
+    void invalidate() { _invalidPages = 0xFF; }
+
+    /**
+     * @brief 合成被修改的页到帧缓冲区
+     * @return 本次合成的页掩码（bit n对应第n页）
+     *
+     * 合成的页会通过markDirtyRegion()登记，之后可用displayDirty()只发送这些页。
+     * 分页渲染模式下没有整帧缓冲区，不做任何处理并返回0
+     */
+    uint8_t compose();
+
+    /**
+     * @brief 合成并刷新被修改的页
+     * @return 本次合成的页掩码
+     */
+    uint8_t present();
+
+private:
+    struct Layer
+    {
+        ST7567_Surface *surface; ///< 图层表面
+        ST7567_Surface *mask;    ///< 掩码表面（BLEND_MASKED）
+        BlendOp op;              ///< 混合方式
+        bool visible;            ///< 是否可见
+    };
+
+    /**
+     * @brief 将一页图层数据混合到目标页（32位字内核）
+     * @param dst 目标页（128字节，4字节对齐）
+     * @param src 图层页
+     * @param mask 掩码页（仅BLEND_MASKED）
+     * @param op 混合方式
+     */
+    static void blendPage(uint8_t *dst, const uint8_t *src, const uint8_t *mask, BlendOp op);
+
+    ST7567_LCD &_lcd;                ///< 合成目标
+    Layer _layers[MAX_LAYERS];       ///< 图层（下标小的在下层）
+    uint8_t _layerCount;             ///< 图层数
+    uint8_t _invalidPages;           ///< 需要强制重新合成的页
+    uint8_t _lastPages;              ///< 上次合成时图层修改的页
+    const uint8_t *_lastTarget;      ///< 上次合成的缓冲区
+    const uint8_t *_prevTarget;      ///< 上上次合成的缓冲区（双缓冲）
+};
+
+#endif // __ST7567_COMPOSITOR_H
@@ -0,0 +1,235 @@
+/**
+ * @file ST7567_ESP32DMA.cpp
+ * @brief ST7567 ESP32 SPI主机DMA异步刷新引擎实现
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#include "ST7567_ESP32DMA.h"
+
+#if defined(ESP32)
+
+#include <soc/gpio_reg.h>
+
+/**
+ * @brief 构造函数
+ * @param host SPI主机
+ * @param sclk 时钟引脚
+ * @param mosi 数据引脚
+ * @param cs 片选引脚
+ * @param dc 数据/命令选择引脚
+ * @param frequency SPI时钟频率
+ */
+ST7567_ESP32DMA::ST7567_ESP32DMA(spi_host_device_t host, int8_t sclk, int8_t mosi, int8_t cs, int8_t dc,
+                                 uint32_t frequency)
+    : _host(host), _sclk(sclk), _mosi(mosi), _cs(cs), _dc(dc), _frequency(frequency),
+      _device(nullptr), _initialized(false), _pending(0), _busy(false)
+{
+}
+
+/**
+ * @brief 析构函数 - 等待传输完成并释放SPI设备
+ */
+ST7567_ESP32DMA::~ST7567_ESP32DMA()
+{
+    if (_initialized)
+    {
+        wait();
+        spi_bus_remove_device(_device);
+        spi_bus_free(_host);
+    }
+}
+
+/**
+ * @brief 初始化SPI总线和设备
+ * @return true:初始化成功
+ *
+ * 配置要点：
+ * - 启用DMA，单事务最大MAX_TRANSFER字节（一页128字节远小于此值）
+ * - CS不交给硬件控制（spics_io_num = -1），由回调在提交首尾切换，
+ *   这样驱动的同步写入仍可用digitalWrite()控制同一引脚
+ * - 队列深度MAX_SEGMENTS，整帧16个事务可一次排队
+ */
+bool ST7567_ESP32DMA::begin()
+{
+    if (_initialized)
+        return true;
+
+    spi_bus_config_t buscfg = {};
+    buscfg.mosi_io_num = _mosi;
+    buscfg.miso_io_num = -1;
+    buscfg.sclk_io_num = _sclk;
+    buscfg.quadwp_io_num = -1;
+    buscfg.quadhd_io_num = -1;
+    buscfg.max_transfer_sz = MAX_TRANSFER;
+
+#ifdef SPI_DMA_CH_AUTO
+    esp_err_t err = spi_bus_initialize(_host, &buscfg, SPI_DMA_CH_AUTO);
+#else
+    esp_err_t err = spi_bus_initialize(_host, &buscfg, 1);
+#endif
+    if (err != ESP_OK)
+    {
+        Serial.printf("ST7567: DMA bus init failed (%d)\n", err);
+        return false;
+    }
+
+    spi_device_interface_config_t devcfg = {};
+    devcfg.clock_speed_hz = _frequency;
+    devcfg.mode = 0;
+    devcfg.spics_io_num = -1;
+    devcfg.queue_size = MAX_SEGMENTS;
+    devcfg.pre_cb = preTransfer;
+    devcfg.post_cb = postTransfer;
+
+    err = spi_bus_add_device(_host, &devcfg, &_device);
+    if (err != ESP_OK)
+    {
+        spi_bus_free(_host);
+        Serial.printf("ST7567: DMA device add failed (%d)\n", err);
+        return false;
+    }
+
+    _initialized = true;
+    Serial.println("ST7567: ESP32 DMA flush engine initialized");
+    return true;
+}
+
+/**
+ * @brief 异步提交一组分段
+ * @param segments 分段数组
+ * @param count 分段数量
+ * @return true:已排队
+ *
+ * 先回收上一次提交的事务结果，再将所有分段一次性放入DMA队列后立即返回
+ */
+bool ST7567_ESP32DMA::submit(const ST7567_FlushSegment *segments, uint8_t count)
+{
+    if (!_initialized || count == 0 || count > MAX_SEGMENTS)
+        return false;
+
+    wait(); // 回收上一次提交
+
+    _busy = true;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        _slots[i].engine = this;
+        _slots[i].dcLevel = segments[i].isData ? 1 : 0;
+        _slots[i].first = (i == 0);
+        _slots[i].last = (i == count - 1);
+
+        memset(&_trans[i], 0, sizeof(spi_transaction_t));
+        _trans[i].length = (size_t)segments[i].length * 8;
+        _trans[i].tx_buffer = segments[i].data;
+        _trans[i].user = &_slots[i];
+
+        if (spi_device_queue_trans(_device, &_trans[i], portMAX_DELAY) != ESP_OK)
+        {
+            // 已排队的事务仍会完成，最后一个不会到达，需手动结束
+            wait();
+            writePin(_cs, HIGH);
+            _busy = false;
+            return false;
+        }
+        _pending++;
+    }
+    return true;
+}
+
+/**
+ * @brief 阻塞等待所有已提交的传输完成
+ */
+void ST7567_ESP32DMA::wait()
+{
+    spi_transaction_t *done;
+    while (_pending > 0)
+    {
+        spi_device_get_trans_result(_device, &done, portMAX_DELAY);
+        _pending--;
+    }
+}
+
+/**
+ * @brief 同步发送原始字节（CS/DC由调用者控制）
+ * @param data 数据指针
+ * @param len 数据长度
+ *
+ * 使用轮询事务，短命令无需中断调度；user为nullptr时回调不改变引脚
+ */
+void ST7567_ESP32DMA::writeBlocking(const uint8_t *data, size_t len)
+{
+    if (!_initialized)
+        return;
+
+    wait();
+    while (len > 0)
+    {
+        size_t n = len < MAX_TRANSFER ? len : MAX_TRANSFER;
+        spi_transaction_t t = {};
+        t.length = n * 8;
+        t.tx_buffer = data;
+        t.user = nullptr;
+        spi_device_polling_transmit(_device, &t);
+        data += n;
+        len -= n;
+    }
+}
+
+/**
+ * @brief 直接写GPIO置位/清零寄存器（中断安全，不依赖flash中的函数）
+ * @param pin 引脚号
+ * @param level 电平
+ */
+void IRAM_ATTR ST7567_ESP32DMA::writePin(int8_t pin, uint8_t level)
+{
+    if (pin < 0)
+        return;
+    if (pin < 32)
+    {
+        REG_WRITE(level ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, 1UL << pin);
+    }
+#ifdef GPIO_OUT1_W1TS_REG
+    else
+    {
+        REG_WRITE(level ? GPIO_OUT1_W1TS_REG : GPIO_OUT1_W1TC_REG, 1UL << (pin - 32));
+    }
+#endif
+}
+
+/**
+ * @brief 事务开始前回调（中断上下文）
+ *
+ * 设置该分段的DC电平，提交中的第一个分段同时拉低CS
+ */
+void IRAM_ATTR ST7567_ESP32DMA::preTransfer(spi_transaction_t *trans)
+{
+    Slot *slot = (Slot *)trans->user;
+    if (slot == nullptr)
+        return;
+
+    writePin(slot->engine->_dc, slot->dcLevel);
+    if (slot->first)
+    {
+        writePin(slot->engine->_cs, LOW);
+    }
+}
+
+/**
+ * @brief 事务完成后回调（中断上下文）
+ *
+ * 最后一个分段完成后拉高CS、清除忙标志并通知完成
+ */
+void IRAM_ATTR ST7567_ESP32DMA::postTransfer(spi_transaction_t *trans)
+{
+    Slot *slot = (Slot *)trans->user;
+    if (slot == nullptr || !slot->last)
+        return;
+
+    ST7567_ESP32DMA *engine = slot->engine;
+    writePin(engine->_cs, HIGH);
+    engine->_busy = false;
+    engine->notifyComplete();
+}
+
+#endif // ESP32
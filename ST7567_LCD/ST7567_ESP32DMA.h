@@ -0,0 +1,87 @@
+/**
+ * @file ST7567_ESP32DMA.h
+ * @brief ST7567 ESP32 SPI主机DMA异步刷新引擎
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 基于ESP-IDF spi_master驱动实现ST7567_FlushEngine接口：
+ * - 每个分段对应一个DMA事务，整帧（8页 × 地址命令+数据）一次性排队
+ * - 事务前回调切换DC并在第一个分段前拉低CS，最后一个分段后拉高CS
+ * - CPU在传输期间可继续渲染下一帧
+ *
+ * @note 引擎独占所选SPI主机，不要再对同一主机调用SPIClass::begin()。
+ * 驱动的同步命令也通过引擎发送，因此可与ST7567_LCD的其他功能混用。
+ */
+
+#ifndef __ST7567_ESP32DMA_H
+#define __ST7567_ESP32DMA_H
+
+#if defined(ESP32)
+
+#include "ST7567_FlushEngine.h"
+#include <driver/spi_master.h>
+
+class ST7567_ESP32DMA : public ST7567_FlushEngine
+{
+public:
+    static const uint8_t MAX_SEGMENTS = 16;      ///< 单次提交最大分段数（8页 × 2）
+    static const uint16_t MAX_TRANSFER = 1024;   ///< 单个DMA事务最大字节数
+
+    /**
+     * @brief 构造函数
+     * @param host SPI主机（如SPI2_HOST/SPI3_HOST，旧版内核为HSPI_HOST/VSPI_HOST）
+     * @param sclk 时钟引脚
+     * @param mosi 数据引脚
+     * @param cs   片选引脚（与ST7567_LCD相同）
+     * @param dc   数据/命令选择引脚（与ST7567_LCD相同）
+     * @param frequency SPI时钟频率（默认40MHz）
+     */
+    ST7567_ESP32DMA(spi_host_device_t host, int8_t sclk, int8_t mosi, int8_t cs, int8_t dc,
+                    uint32_t frequency = 40000000);
+
+    /**
+     * @brief 析构函数 - 等待传输完成并释放SPI设备
+     */
+    ~ST7567_ESP32DMA();
+
+    bool begin() override;
+    bool submit(const ST7567_FlushSegment *segments, uint8_t count) override;
+    bool isBusy() override { return _busy; }
+    void wait() override;
+    void writeBlocking(const uint8_t *data, size_t len) override;
+
+private:
+    /**
+     * @brief 事务上下文（通过spi_transaction_t::user传给回调）
+     */
+    struct Slot
+    {
+        ST7567_ESP32DMA *engine; ///< 所属引擎
+        uint8_t dcLevel;         ///< 该分段的DC电平
+        bool first;              ///< 提交中的第一个分段（拉低CS）
+        bool last;               ///< 提交中的最后一个分段（拉高CS并通知完成）
+    };
+
+    static void IRAM_ATTR preTransfer(spi_transaction_t *trans);
+    static void IRAM_ATTR postTransfer(spi_transaction_t *trans);
+    static void IRAM_ATTR writePin(int8_t pin, uint8_t level);
+
+    spi_host_device_t _host;      ///< SPI主机
+    int8_t _sclk;                 ///< 时钟引脚
+    int8_t _mosi;                 ///< 数据引脚
+    int8_t _cs;                   ///< 片选引脚
+    int8_t _dc;                   ///< 数据/命令选择引脚
+    uint32_t _frequency;          ///< SPI时钟频率
+    spi_device_handle_t _device;  ///< spi_master设备句柄
+    bool _initialized;            ///< 总线是否已初始化
+
+    spi_transaction_t _trans[MAX_SEGMENTS]; ///< 排队中的DMA事务
+    Slot _slots[MAX_SEGMENTS];              ///< 事务上下文
+    uint8_t _pending;                       ///< 已排队但未回收的事务数
+    volatile bool _busy;                    ///< 提交进行中标志（中断中清除）
+};
+
+#endif // ESP32
+
+#endif // __ST7567_ESP32DMA_H
@@ -0,0 +1,129 @@
+/**
+ * @file ST7567_FlushEngine.h
+ * @brief ST7567异步刷新传输引擎接口
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 将"刷新一帧"描述为一组命令/数据分段，由具体引擎在后台发送。
+ * ST7567_LCD只负责生成分段序列（每页3字节地址命令 + 128字节数据），
+ * 传输细节（DMA描述符、中断、CS/DC时序）由引擎实现：
+ * - ST7567_ESP32DMA：ESP32 SPI主机DMA实现
+ * - test/host/mock/MockFlushEngine.h：主机测试用模拟引擎，记录分段并按测试的节奏完成（make -C test/host）
+ *
+ * 使用示例：
+ * @code
+ * ST7567_LCD lcd(CS_PIN, RST_PIN, DC_PIN);
+ * ST7567_ESP32DMA dma(SPI2_HOST, SCLK_PIN, MOSI_PIN, CS_PIN, DC_PIN);
+ *
+ * void setup() {
+ *     lcd.setFlushEngine(&dma);
+ *     lcd.begin();
+ * }
+ *
+ * void loop() {
+ *     drawFrame();          // 渲染下一帧
+ *     lcd.displayAsync();   // 快照后立即返回，DMA在后台发送
+ * }
+ * @endcode
+ */
+
+#ifndef __ST7567_FLUSH_ENGINE_H
+#define __ST7567_FLUSH_ENGINE_H
+
+#include <Arduino.h>
+
+/**
+ * @brief 传输分段
+ *
+ * 一次提交中的分段按顺序发送，整个提交期间CS保持有效，
+ * 只在命令/数据分段边界切换DC
+ */
+struct ST7567_FlushSegment
+{
+    const uint8_t *data; ///< 分段数据指针（传输完成前必须保持有效）
+    uint16_t length;     ///< 分段字节数
+    bool isData;         ///< true:显示数据（DC高）, false:命令（DC低）
+};
+
+/**
+ * @brief 刷新完成回调
+ * @param context 用户上下文指针
+ *
+ * @note ESP32 DMA引擎在中断上下文中调用，回调内只能做置位/通知等轻量操作
+ */
+typedef void (*ST7567_FlushCallback)(void *context);
+
+/**
+ * @brief 异步刷新传输引擎接口
+ */
+class ST7567_FlushEngine
+{
+public:
+    ST7567_FlushEngine() : _callback(nullptr), _callbackContext(nullptr) {}
+    virtual ~ST7567_FlushEngine() {}
+
+    /**
+     * @brief 初始化传输引擎（由ST7567_LCD::begin()调用）
+     * @return true:初始化成功
+     */
+    virtual bool begin() = 0;
+
+    /**
+     * @brief 异步提交一组分段
+     * @param segments 分段数组（引擎在返回前复制描述，数据本身需保持有效）
+     * @param count 分段数量
+     * @return true:已排队, false:引擎忙或队列不足
+     *
+     * 第一个分段前拉低CS，最后一个分段后拉高CS，全部完成后调用完成回调
+     */
+    virtual bool submit(const ST7567_FlushSegment *segments, uint8_t count) = 0;
+
+    /**
+     * @brief 查询是否有未完成的提交
+     * @return true:传输进行中
+     */
+    virtual bool isBusy() = 0;
+
+    /**
+     * @brief 阻塞等待所有已提交的传输完成
+     */
+    virtual void wait() = 0;
+
+    /**
+     * @brief 同步发送原始字节（CS/DC由调用者控制）
+     * @param data 数据指针
+     * @param len 数据长度
+     *
+     * 引擎接管SPI总线后，驱动的命令和局部刷新也通过此接口发送
+     */
+    virtual void writeBlocking(const uint8_t *data, size_t len) = 0;
+
+    /**
+     * @brief 设置刷新完成回调
+     * @param callback 回调函数（nullptr取消）
+     * @param context 传给回调的用户上下文
+     */
+    void setCompletionCallback(ST7567_FlushCallback callback, void *context)
+    {
+        _callback = callback;
+        _callbackContext = context;
+    }
+
+protected:
+    /**
+     * @brief 通知一次提交已完成（由具体引擎调用）
+     */
+    inline void notifyComplete()
+    {
+        if (_callback != nullptr)
+        {
+            _callback(_callbackContext);
+        }
+    }
+
+    ST7567_FlushCallback _callback; ///< 完成回调
+    void *_callbackContext;         ///< 回调上下文
+};
+
+#endif // __ST7567_FLUSH_ENGINE_H
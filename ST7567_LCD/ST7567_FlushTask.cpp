@@ -0,0 +1,333 @@
+/**
+ * @file ST7567_FlushTask.cpp
+ * @brief ST7567 ESP32双核后台刷新任务实现
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#if defined(ESP32)
+
+#include "ST7567_FlushTask.h"
+
+static_assert((ST7567_FlushTask::RING_SIZE & (ST7567_FlushTask::RING_SIZE - 1)) == 0,
+              "RING_SIZE must be a power of two");
+static_assert(ST7567_FlushTask::RING_SIZE >= ST7567_FlushTask::BUFFER_COUNT - 1,
+              "RING_SIZE must hold every buffer but the one being drawn");
+
+/**
+ * @brief 构造函数
+ * @param lcd 显示屏
+ */
+ST7567_FlushTask::ST7567_FlushTask(ST7567_LCD &lcd)
+    : _lcd(lcd), _drawIndex(0), _policy(PRESENT_BLOCK), _task(nullptr), _savedOwnBuffer(nullptr),
+      _waiter(nullptr), _stopping(false), _stopped(false), _presented(0), _sent(0), _dropped(0), _overwritten(0)
+{
+    for (uint8_t i = 0; i < BUFFER_COUNT; i++)
+    {
+        _buffers[i] = nullptr;
+    }
+    _ready.head = _ready.tail = 0;
+    _free.head = _free.tail = 0;
+}
+
+/**
+ * @brief 析构函数
+ */
+ST7567_FlushTask::~ST7567_FlushTask()
+{
+    end();
+}
+
+/**
+ * @brief 入队（只能由该环的唯一生产者调用）
+ * @return false:环已满
+ */
+bool ST7567_FlushTask::ringPush(IndexRing &ring, uint8_t index)
+{
+    uint8_t head = ring.head.load(std::memory_order_relaxed);
+    if ((uint8_t)(head - ring.tail.load(std::memory_order_acquire)) >= RING_SIZE)
+        return false;
+
+    ring.slots[head & (RING_SIZE - 1)] = index;
+    ring.head.store(head + 1, std::memory_order_release); // 发布编号
+    return true;
+}
+
+/**
+ * @brief 出队
+ * @return false:环为空
+ *
+ * 先读出编号再用CAS推进读位置：PRESENT_OVERWRITE时应用会和任务同时从就绪环出队，
+ * CAS保证每个编号只被一方取得；生产者在读位置越过该槽之前不会覆盖它
+ */
+bool ST7567_FlushTask::ringPop(IndexRing &ring, uint8_t &index)
+{
+    uint8_t tail = ring.tail.load(std::memory_order_acquire);
+    for (;;)
+    {
+        if (tail == ring.head.load(std::memory_order_acquire))
+            return false;
+
+        uint8_t value = ring.slots[tail & (RING_SIZE - 1)];
+        if (ring.tail.compare_exchange_weak(tail, (uint8_t)(tail + 1), std::memory_order_acq_rel,
+                                            std::memory_order_acquire))
+        {
+            index = value;
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief 环中的元素数
+ */
+uint8_t ST7567_FlushTask::ringCount(const IndexRing &ring)
+{
+    return (uint8_t)(ring.head.load(std::memory_order_acquire) - ring.tail.load(std::memory_order_acquire));
+}
+
+/**
+ * @brief 分配缓冲区并启动刷新任务
+ * @return true:启动成功
+ *
+ * 0号缓冲区就是驱动原来的绘制目标（保留已绘制的内容，可以是attachFrameBuffer()绑定的
+ * 外部缓冲区），另分配BUFFER_COUNT - 1个，通过attachFrameBuffer()以非所有权方式交给驱动。
+ * 原来的绑定关系记下，end()时恢复
+ */
+bool ST7567_FlushTask::begin(OverrunPolicy policy, int8_t core, UBaseType_t priority, uint32_t stackSize)
+{
+    if (_task != nullptr || _lcd.isPageMode() || _lcd._frontBuffer != nullptr)
+        return false;
+
+    _lcd.waitFlush();
+    _policy = policy;
+    _buffers[0] = _lcd.getFrameBuffer();
+    _savedOwnBuffer = _lcd._ownBuffer;
+    for (uint8_t i = 1; i < BUFFER_COUNT; i++)
+    {
+        _buffers[i] = new uint8_t[ST7567_LCD::FRAME_SIZE]();
+    }
+    _lcd.attachFrameBuffer(_buffers[0]);
+
+    _drawIndex = 0;
+    _ready.head = _ready.tail = 0;
+    _free.head = _free.tail = 0;
+    for (uint8_t i = 1; i < BUFFER_COUNT; i++)
+    {
+        ringPush(_free, i);
+    }
+
+    _stopping = false;
+    _stopped = false;
+    _waiter = nullptr;
+
+    if (core < 0)
+    {
+#if CONFIG_FREERTOS_UNICORE
+        core = 0;
+#else
+        core = xPortGetCoreID() ^ 1; // Arduino的loop()在1号核心，刷新任务默认在0号核心
+#endif
+    }
+
+    if (xTaskCreatePinnedToCore(taskEntry, "st7567_flush", stackSize, this, priority, &_task, core) != pdPASS)
+    {
+        _task = nullptr;
+        end();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 停止任务并释放额外的缓冲区
+ *
+ * 当前绘制的内容复制回0号缓冲区，驱动恢复begin()之前的绘制目标和绑定关系
+ * （调用者绑定的外部缓冲区保持绑定）
+ */
+void ST7567_FlushTask::end()
+{
+    if (_task != nullptr)
+    {
+        waitIdle();
+        _stopping = true;
+        xTaskNotifyGive(_task);
+        while (!_stopped)
+        {
+            vTaskDelay(1);
+        }
+        _task = nullptr;
+    }
+
+    if (_buffers[0] == nullptr)
+        return;
+
+    if (_lcd.frameBuffer != _buffers[0])
+    {
+        memcpy(_buffers[0], _lcd.frameBuffer, ST7567_LCD::FRAME_SIZE);
+    }
+    _lcd.frameBuffer = _buffers[0];
+    _lcd._ownBuffer = _savedOwnBuffer;
+    _savedOwnBuffer = nullptr;
+    _lcd.markAllDirty();
+    for (uint8_t i = 1; i < BUFFER_COUNT; i++)
+    {
+        delete[] _buffers[i];
+    }
+    for (uint8_t i = 0; i < BUFFER_COUNT; i++)
+    {
+        _buffers[i] = nullptr;
+    }
+}
+
+/**
+ * @brief 等待任务放回空闲缓冲区
+ *
+ * 先登记等待者再重试一次，任务放回缓冲区后用任务通知唤醒，避免忙等；
+ * 超时只是防止错过通知，不影响正确性
+ */
+void ST7567_FlushTask::waitFree(uint8_t &index)
+{
+    _waiter = xTaskGetCurrentTaskHandle();
+    while (!ringPop(_free, index))
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+    }
+    _waiter = nullptr;
+}
+
+/**
+ * @brief 提交当前帧
+ * @param mode 新绘制缓冲区的内容
+ * @return true:已提交
+ *
+ * 提交流程：
+ * 1. 从空闲环取下一个缓冲区，取不到时按策略处理
+ * 2. 当前缓冲区编号放入就绪环，通知任务
+ * 3. 按mode准备新缓冲区，切换驱动的绘制目标
+ */
+bool ST7567_FlushTask::present(ST7567_LCD::SwapMode mode)
+{
+    if (_task == nullptr)
+    {
+        _lcd.display();
+        return true;
+    }
+
+    uint8_t next;
+    if (!ringPop(_free, next))
+    {
+        switch (_policy)
+        {
+        case PRESENT_DROP:
+            _dropped++;
+            return false;
+
+        case PRESENT_OVERWRITE:
+            // 收回最早排队、任务尚未取走的帧；全部在发送中时只能等待
+            if (ringPop(_ready, next))
+            {
+                _overwritten++;
+                break;
+            }
+            waitFree(next);
+            break;
+
+        case PRESENT_BLOCK:
+        default:
+            waitFree(next);
+            break;
+        }
+    }
+
+    const uint8_t *drawn = _buffers[_drawIndex];
+    ringPush(_ready, _drawIndex);
+    xTaskNotifyGive(_task);
+    _presented++;
+
+    // 任务只读取已提交的缓冲区，这里可以同时复制
+    uint8_t *target = _buffers[next];
+    switch (mode)
+    {
+    case ST7567_LCD::SWAP_COPY:
+        memcpy(target, drawn, ST7567_LCD::FRAME_SIZE);
+        break;
+    case ST7567_LCD::SWAP_CLEAR:
+        memset(target, 0x00, ST7567_LCD::FRAME_SIZE);
+        break;
+    case ST7567_LCD::SWAP_KEEP:
+    default:
+        break;
+    }
+
+    // 任务整帧发送，不读也不清除脏区记录；脏区状态归应用线程，在这里随帧清除
+    _drawIndex = next;
+    _lcd.clearDirty();
+    _lcd.frameBuffer = target;
+    return true;
+}
+
+/**
+ * @brief 等待所有已提交的帧发送完毕
+ */
+void ST7567_FlushTask::waitIdle()
+{
+    if (_task == nullptr)
+        return;
+
+    _waiter = xTaskGetCurrentTaskHandle();
+    while (ringCount(_free) < BUFFER_COUNT - 1)
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+    }
+    _waiter = nullptr;
+}
+
+/**
+ * @brief 任务入口
+ */
+void ST7567_FlushTask::taskEntry(void *arg)
+{
+    static_cast<ST7567_FlushTask *>(arg)->taskLoop();
+    vTaskDelete(nullptr);
+}
+
+/**
+ * @brief 任务主循环
+ *
+ * 有传输引擎且未启用差分时提交DMA并等待（核心在传输期间可调度其他任务），
+ * 否则同步发送（影子缓冲区有效时只发送差异）。
+ * 应用核心同时在绘制，发送走sendFrameRaw()，不修改脏区记录和性能统计；
+ * 脏区记录由应用线程在present()切换缓冲区时清除
+ */
+void ST7567_FlushTask::taskLoop()
+{
+    for (;;)
+    {
+        uint8_t index;
+        if (!ringPop(_ready, index))
+        {
+            if (_stopping)
+                break;
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        if (_lcd._displayEnabled)
+        {
+            _lcd.sendFrameRaw(_buffers[index]);
+        }
+        _sent++;
+
+        ringPush(_free, index);
+        TaskHandle_t waiter = _waiter.load();
+        if (waiter != nullptr)
+        {
+            xTaskNotifyGive(waiter);
+        }
+    }
+    _stopped = true;
+}
+
+#endif // ESP32
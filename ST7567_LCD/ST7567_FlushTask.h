@@ -0,0 +1,166 @@
+/**
+ * @file ST7567_FlushTask.h
+ * @brief ST7567 ESP32双核后台刷新任务
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 在另一个CPU核心上运行的刷新任务，应用核心只负责绘制：
+ * - 三个帧缓冲区轮转：一个绘制中，其余排队或发送中
+ * - 应用→任务、任务→应用各一个单生产者/单消费者索引环，热路径只有原子读写，无互斥锁
+ * - present()把绘制完成的缓冲区编号放入就绪环并换到空闲缓冲区继续绘制，立即返回
+ * - 任务取出编号整帧发送（有传输引擎且未启用差分时走DMA），发送完毕放回空闲环
+ *
+ * 生产快于消费（没有空闲缓冲区）时的处理策略：
+ * - PRESENT_DROP：丢弃本帧，继续在同一缓冲区绘制，present()返回false
+ * - PRESENT_BLOCK：等待任务放回缓冲区，每帧都会显示
+ * - PRESENT_OVERWRITE：收回最早排队但尚未发送的帧，用新帧代替（显示总是最新的）
+ *
+ * 典型用法：
+ * @code
+ * ST7567_FlushTask flushTask(lcd);
+ *
+ * void setup() {
+ *     lcd.begin();
+ *     flushTask.begin(ST7567_FlushTask::PRESENT_OVERWRITE);
+ * }
+ *
+ * void loop() {
+ *     lcd.clearDisplay();
+ *     drawFrame();
+ *     flushTask.present(ST7567_LCD::SWAP_KEEP);
+ * }
+ * @endcode
+ *
+ * @note 任务运行期间刷新由任务完成，应用不要再调用display()/displayDirty()等刷新函数和
+ * 控制命令；不能与页模式、常驻双缓冲同时使用。
+ * 任务不修改驱动的脏区记录和性能统计（应用核心同时在写），脏区记录在present()时清除，
+ * 发送的帧数见getSent()
+ */
+
+#ifndef __ST7567_FLUSH_TASK_H
+#define __ST7567_FLUSH_TASK_H
+
+#if defined(ESP32)
+
+#include "ST7567_LCD.h"
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+class ST7567_FlushTask
+{
+public:
+    static const uint8_t BUFFER_COUNT = 3; ///< 帧缓冲区数（驱动原来的绘制目标 + 额外分配2个）
+    static const uint8_t RING_SIZE = 4;    ///< 索引环容量（2的幂，不小于BUFFER_COUNT - 1）
+
+    /**
+     * @brief 没有空闲缓冲区时present()的处理策略
+     */
+    enum OverrunPolicy
+    {
+        PRESENT_DROP,     ///< 丢弃新帧
+        PRESENT_BLOCK,    ///< 阻塞等待
+        PRESENT_OVERWRITE ///< 用新帧替换最早排队的帧
+    };
+
+    /**
+     * @brief 构造函数
+     * @param lcd 显示屏（需已调用begin()）
+     */
+    ST7567_FlushTask(ST7567_LCD &lcd);
+
+    /**
+     * @brief 析构函数 - 停止任务
+     */
+    ~ST7567_FlushTask();
+
+    /**
+     * @brief 分配缓冲区并启动刷新任务
+     * @param policy 生产快于消费时的策略
+     * @param core 任务运行的核心（-1:调用者所在核心之外的另一个核心，单核芯片为0）
+     * @param priority 任务优先级
+     * @param stackSize 任务栈大小（字节）
+     * @return true:启动成功
+     */
+    bool begin(OverrunPolicy policy = PRESENT_BLOCK, int8_t core = -1,
+               UBaseType_t priority = 1, uint32_t stackSize = 3072);
+
+    /**
+     * @brief 发送完已提交的帧后停止任务，驱动恢复使用自有缓冲区
+     */
+    void end();
+
+    /**
+     * @brief 提交当前绘制的帧并切换到下一个缓冲区
+     * @param mode 新绘制缓冲区的内容：SWAP_COPY复制刚提交的帧，SWAP_CLEAR清零，SWAP_KEEP不处理
+     * @return true:已提交, false:按PRESENT_DROP丢弃了本帧
+     *
+     * 任务未运行时退化为同步display()
+     */
+    bool present(ST7567_LCD::SwapMode mode = ST7567_LCD::SWAP_COPY);
+
+    /**
+     * @brief 阻塞等待所有已提交的帧发送完毕
+     */
+    void waitIdle();
+
+    /**
+     * @brief 设置生产快于消费时的策略
+     */
+    void setPolicy(OverrunPolicy policy) { _policy = policy; }
+
+    /**
+     * @brief 任务是否运行中
+     */
+    bool isRunning() const { return _task != nullptr; }
+
+    uint32_t getPresented() const { return _presented; }     ///< 已提交帧数
+    uint32_t getSent() const { return _sent.load(); }        ///< 已发送帧数
+    uint32_t getDropped() const { return _dropped; }         ///< PRESENT_DROP丢弃的帧数
+    uint32_t getOverwritten() const { return _overwritten; } ///< PRESENT_OVERWRITE替换的帧数
+
+private:
+    /**
+     * @brief 缓冲区编号环（一个生产者；出队用CAS，允许生产者收回排队的帧）
+     */
+    struct IndexRing
+    {
+        uint8_t slots[RING_SIZE];
+        std::atomic<uint8_t> head; ///< 写位置（生产者）
+        std::atomic<uint8_t> tail; ///< 读位置
+    };
+
+    static bool ringPush(IndexRing &ring, uint8_t index);
+    static bool ringPop(IndexRing &ring, uint8_t &index);
+    static uint8_t ringCount(const IndexRing &ring);
+
+    static void taskEntry(void *arg);
+    void taskLoop();
+
+    /**
+     * @brief 等待任务放回空闲缓冲区
+     * @param index 取到的缓冲区编号
+     */
+    void waitFree(uint8_t &index);
+
+    ST7567_LCD &_lcd;                        ///< 显示屏
+    uint8_t *_buffers[BUFFER_COUNT];         ///< 帧缓冲区（0号为begin()之前驱动的绘制目标）
+    uint8_t _drawIndex;                      ///< 应用正在绘制的缓冲区
+    IndexRing _ready;                        ///< 待发送（应用→任务）
+    IndexRing _free;                         ///< 空闲（任务→应用）
+    OverrunPolicy _policy;                   ///< 生产快于消费时的策略
+    TaskHandle_t _task;                      ///< 刷新任务
+    uint8_t *_savedOwnBuffer;                ///< begin()之前驱动保存的自有缓冲区（未绑定外部缓冲区时为nullptr）
+    std::atomic<TaskHandle_t> _waiter;       ///< 等待空闲缓冲区的应用任务
+    std::atomic<bool> _stopping;             ///< 请求停止
+    std::atomic<bool> _stopped;              ///< 任务已退出循环
+    uint32_t _presented;                     ///< 已提交帧数
+    std::atomic<uint32_t> _sent;             ///< 已发送帧数
+    uint32_t _dropped;                       ///< 丢弃帧数
+    uint32_t _overwritten;                   ///< 替换帧数
+};
+
+#endif // ESP32
+
+#endif // __ST7567_FLUSH_TASK_H
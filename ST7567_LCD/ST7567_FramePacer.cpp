@@ -0,0 +1,215 @@
+/**
+ * @file ST7567_FramePacer.cpp
+ * @brief ST7567 帧节拍调度器实现
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#include "ST7567_FramePacer.h"
+
+/**
+ * @brief 构造函数
+ * @param lcd 显示屏驱动
+ * @param targetFps 目标帧率
+ */
+ST7567_FramePacer::ST7567_FramePacer(ST7567_LCD &lcd, uint16_t targetFps)
+    : _lcd(lcd), _callback(nullptr), _context(nullptr), _flushMode(PACE_DISPLAY),
+      _nextFrame(0), _frame(0), _started(false), _lastOverBudget(false)
+{
+    setTargetFps(targetFps);
+    resetStats();
+}
+
+/**
+ * @brief 设置目标帧率
+ * @param fps 帧率
+ *
+ * 例：30fps → 33333us，60fps → 16666us
+ */
+void ST7567_FramePacer::setTargetFps(uint16_t fps)
+{
+    if (fps == 0)
+        fps = 1;
+    if (fps > 1000)
+        fps = 1000;
+    _period = 1000000UL / fps;
+}
+
+/**
+ * @brief 设置渲染回调
+ * @param callback 回调函数
+ * @param context 用户上下文
+ */
+void ST7567_FramePacer::setRenderCallback(ST7567_RenderCallback callback, void *context)
+{
+    _callback = callback;
+    _context = context;
+}
+
+/**
+ * @brief 非阻塞调度
+ * @return true:本次调用渲染了一帧
+ *
+ * 调度流程：
+ * 1. 未到节拍立即返回
+ * 2. 开始延迟 = 当前时间 - 节拍时间，超过一个周期时跳过过期节拍（不补画）
+ * 3. 调用渲染回调，计时绘制部分
+ * 4. 按刷新方式刷新，计时刷新部分
+ * 5. 节拍按周期累加（不以完成时间为基准），长期帧率不漂移
+ */
+bool ST7567_FramePacer::update()
+{
+    uint32_t now = micros();
+    if (!_started)
+    {
+        _nextFrame = now;
+        _started = true;
+    }
+
+    if ((int32_t)(now - _nextFrame) < 0)
+        return false; // 未到节拍
+
+    uint32_t late = now - _nextFrame;
+    uint32_t missed = late / _period;
+    if (missed > 0)
+    {
+        // 合并过期节拍：只渲染一次，帧号跟上实际时间
+        _skipped += missed;
+        _frame += missed;
+        late -= missed * _period;
+    }
+    _nextFrame += (missed + 1) * _period;
+
+    uint32_t t0 = micros();
+    if (_callback != nullptr)
+    {
+        _callback(_lcd, _frame, _context);
+    }
+    uint32_t t1 = micros();
+
+    switch (_flushMode)
+    {
+    case PACE_DISPLAY:
+        _lcd.display();
+        break;
+    case PACE_DIRTY:
+        _lcd.displayDirty();
+        break;
+    case PACE_ASYNC:
+        _lcd.displayAsync();
+        break;
+    default:
+        break;
+    }
+    uint32_t t2 = micros();
+
+    uint32_t drawTime = t1 - t0;
+    uint32_t flushTime = t2 - t1;
+    _lastOverBudget = (drawTime + flushTime) > _period;
+
+    _frame++;
+    _frames++;
+    if (_lastOverBudget)
+        _overBudget++;
+    _drawSum += drawTime;
+    _flushSum += flushTime;
+    _jitterSum += late;
+    if (drawTime > _drawMax)
+        _drawMax = drawTime;
+    if (flushTime > _flushMax)
+        _flushMax = flushTime;
+    if (late < _jitterMin)
+        _jitterMin = late;
+    if (late > _jitterMax)
+        _jitterMax = late;
+
+    return true;
+}
+
+/**
+ * @brief 阻塞调度
+ */
+void ST7567_FramePacer::run()
+{
+    if (_started)
+    {
+        for (;;)
+        {
+            int32_t remaining = (int32_t)(_nextFrame - micros());
+            if (remaining <= 0)
+                break;
+            if (remaining > 2000)
+                delay(remaining / 1000 - 1);
+            else
+                delayMicroseconds(remaining);
+        }
+    }
+    update();
+}
+
+/**
+ * @brief 获取统计数据
+ * @return 统计结构体（无帧时各项为0）
+ */
+ST7567_FrameStats ST7567_FramePacer::getStats() const
+{
+    ST7567_FrameStats stats;
+    stats.frames = _frames;
+    stats.skipped = _skipped;
+    stats.overBudget = _overBudget;
+    stats.drawMax = _drawMax;
+    stats.flushMax = _flushMax;
+    stats.jitterMax = _jitterMax;
+
+    if (_frames > 0)
+    {
+        stats.drawAvg = (uint32_t)(_drawSum / _frames);
+        stats.flushAvg = (uint32_t)(_flushSum / _frames);
+        stats.jitterMin = _jitterMin;
+        stats.jitterAvg = (uint32_t)(_jitterSum / _frames);
+        uint32_t load = (uint32_t)((_drawSum + _flushSum) * 100 / ((uint64_t)_frames * _period));
+        stats.load = load > 255 ? 255 : load;
+    }
+    else
+    {
+        stats.drawAvg = 0;
+        stats.flushAvg = 0;
+        stats.jitterMin = 0;
+        stats.jitterAvg = 0;
+        stats.load = 0;
+    }
+    return stats;
+}
+
+/**
+ * @brief 清除统计数据
+ */
+void ST7567_FramePacer::resetStats()
+{
+    _frames = 0;
+    _skipped = 0;
+    _overBudget = 0;
+    _drawSum = 0;
+    _drawMax = 0;
+    _flushSum = 0;
+    _flushMax = 0;
+    _jitterSum = 0;
+    _jitterMin = 0xFFFFFFFF;
+    _jitterMax = 0;
+}
+
+/**
+ * @brief 通过串口输出统计数据（调试用）
+ */
+void ST7567_FramePacer::printStats()
+{
+    ST7567_FrameStats s = getStats();
+    Serial.printf("FramePacer: %lu frames, %lu skipped, %lu over budget (%lu us), load %u%%\n",
+                  (unsigned long)s.frames, (unsigned long)s.skipped, (unsigned long)s.overBudget,
+                  (unsigned long)_period, s.load);
+    Serial.printf("  draw avg/max: %lu/%lu us, flush avg/max: %lu/%lu us, jitter min/avg/max: %lu/%lu/%lu us\n",
+                  (unsigned long)s.drawAvg, (unsigned long)s.drawMax,
+                  (unsigned long)s.flushAvg, (unsigned long)s.flushMax,
+                  (unsigned long)s.jitterMin, (unsigned long)s.jitterAvg, (unsigned long)s.jitterMax);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file ST7567_FramePacer.h
+ * @brief ST7567 帧节拍调度器（固定帧率 + 帧时间预算）
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 以目标帧率调用渲染回调并刷新显示：
+ * - 按micros()分别测量绘制时间和刷新时间
+ * - 帧周期 = 1000000 / 目标帧率，绘制+刷新超过周期记为超预算
+ * - 错过的帧不补画：跳过已过期的节拍，只渲染一次，帧号按经过的节拍数前进，
+ *   以帧号驱动的动画在超负荷时仍保持正确的速度
+ * - 统计每帧开始时间相对理想节拍的抖动（最小/平均/最大）
+ *
+ * 使用示例：
+ * @code
+ * ST7567_LCD lcd(CS_PIN, RST_PIN, DC_PIN);
+ * ST7567_FramePacer pacer(lcd, 60);
+ *
+ * void render(ST7567_LCD &lcd, uint32_t frame, void *) {
+ *     lcd.clearDisplay();
+ *     lcd.fillRect(frame % 128, 28, 8, 8, ST7567_WHITE);
+ * }
+ *
+ * void setup() {
+ *     lcd.begin();
+ *     pacer.setRenderCallback(render);
+ * }
+ *
+ * void loop() {
+ *     pacer.update();   // 未到节拍时立即返回，可继续处理其他任务
+ * }
+ * @endcode
+ */
+
+#ifndef __ST7567_FRAME_PACER_H
+#define __ST7567_FRAME_PACER_H
+
+#include "ST7567_LCD.h"
+
+/**
+ * @brief 渲染回调
+ * @param lcd 显示屏驱动
+ * @param frame 帧号（按节拍计数，包含被跳过的节拍）
+ * @param context 用户上下文
+ */
+typedef void (*ST7567_RenderCallback)(ST7567_LCD &lcd, uint32_t frame, void *context);
+
+/**
+ * @brief 帧时间统计（时间单位：微秒）
+ */
+struct ST7567_FrameStats
+{
+    uint32_t frames;      ///< 已渲染帧数
+    uint32_t skipped;     ///< 因超时跳过的节拍数
+    uint32_t overBudget;  ///< 绘制+刷新超过帧周期的帧数
+    uint32_t drawAvg;     ///< 平均绘制时间
+    uint32_t drawMax;     ///< 最大绘制时间
+    uint32_t flushAvg;    ///< 平均刷新时间
+    uint32_t flushMax;    ///< 最大刷新时间
+    uint32_t jitterMin;   ///< 最小开始延迟（相对理想节拍）
+    uint32_t jitterAvg;   ///< 平均开始延迟
+    uint32_t jitterMax;   ///< 最大开始延迟
+    uint8_t load;         ///< 平均帧时间占帧周期的百分比
+};
+
+class ST7567_FramePacer
+{
+public:
+    /**
+     * @brief 每帧的刷新方式
+     */
+    enum FlushMode
+    {
+        PACE_DISPLAY, ///< display()（默认，影子缓冲区启用时为差分刷新）
+        PACE_DIRTY,   ///< displayDirty()，只发送脏区
+        PACE_ASYNC,   ///< displayAsync()，刷新时间只包含快照和提交
+        PACE_NONE     ///< 回调自行刷新
+    };
+
+    /**
+     * @brief 构造函数
+     * @param lcd 显示屏驱动
+     * @param targetFps 目标帧率（默认30）
+     */
+    ST7567_FramePacer(ST7567_LCD &lcd, uint16_t targetFps = 30);
+
+    /**
+     * @brief 设置目标帧率
+     * @param fps 帧率（1-1000，0按1处理）
+     */
+    void setTargetFps(uint16_t fps);
+
+    /**
+     * @brief 设置渲染回调
+     * @param callback 回调函数
+     * @param context 传给回调的用户上下文
+     */
+    void setRenderCallback(ST7567_RenderCallback callback, void *context = nullptr);
+
+    /**
+     * @brief 设置刷新方式
+     * @param mode 刷新方式
+     */
+    void setFlushMode(FlushMode mode) { _flushMode = mode; }
+
+    /**
+     * @brief 非阻塞调度：到达节拍时渲染并刷新一帧
+     * @return true:本次调用渲染了一帧
+     */
+    bool update();
+
+    /**
+     * @brief 阻塞调度：等待到下一节拍后渲染并刷新一帧
+     *
+     * 剩余时间较长时用delay()让出CPU，最后不足2ms用delayMicroseconds()对齐
+     */
+    void run();
+
+    /**
+     * @brief 重新开始计时（下一次update()立即渲染）
+     */
+    void restart() { _started = false; }
+
+    /**
+     * @brief 获取统计数据
+     * @return 统计结构体
+     */
+    ST7567_FrameStats getStats() const;
+
+    /**
+     * @brief 清除统计数据
+     */
+    void resetStats();
+
+    /**
+     * @brief 最近一帧是否超出帧时间预算
+     * @return true:绘制+刷新超过帧周期
+     */
+    bool isOverBudget() const { return _lastOverBudget; }
+
+    /**
+     * @brief 获取帧周期
+     * @return 微秒
+     */
+    uint32_t getFramePeriod() const { return _period; }
+
+    /**
+     * @brief 通过串口输出统计数据（调试用）
+     */
+    void printStats();
+
+private:
+    ST7567_LCD &_lcd;                 ///< 显示屏驱动
+    ST7567_RenderCallback _callback;  ///< 渲染回调
+    void *_context;                   ///< 回调上下文
+    FlushMode _flushMode;             ///< 刷新方式
+
+    uint32_t _period;                 ///< 帧周期（微秒）
+    uint32_t _nextFrame;              ///< 下一节拍时间（micros()）
+    uint32_t _frame;                  ///< 帧号
+    bool _started;                    ///< 是否已确定第一个节拍
+    bool _lastOverBudget;             ///< 最近一帧超预算
+
+    // 统计累计值
+    uint32_t _frames;                 ///< 已渲染帧数
+    uint32_t _skipped;                ///< 跳过的节拍数
+    uint32_t _overBudget;             ///< 超预算帧数
+    uint64_t _drawSum;                ///< 绘制时间累计
+    uint32_t _drawMax;                ///< 最大绘制时间
+    uint64_t _flushSum;               ///< 刷新时间累计
+    uint32_t _flushMax;               ///< 最大刷新时间
+    uint64_t _jitterSum;              ///< 开始延迟累计
+    uint32_t _jitterMin;              ///< 最小开始延迟
+    uint32_t _jitterMax;              ///< 最大开始延迟
+};
+
+#endif // __ST7567_FRAME_PACER_H
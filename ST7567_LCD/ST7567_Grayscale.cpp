@@ -0,0 +1,384 @@
+/**
+ * @file ST7567_Grayscale.cpp
+ * @brief ST7567 时间抖动4级灰度实现
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#include "ST7567_Grayscale.h"
+
+/**
+ * @brief 各相位显示的平面（0:低位, 1:高位），高位平面占2个子帧
+ */
+static const uint8_t PHASE_PLANE[ST7567_Grayscale::PHASE_COUNT] = {0, 1, 1};
+
+/**
+ * @brief 构造函数
+ * @param lcd 显示屏驱动
+ */
+ST7567_Grayscale::ST7567_Grayscale(ST7567_LCD &lcd)
+    : Adafruit_GFX(ST7567_LCD::LCD_WIDTH, ST7567_LCD::LCD_HEIGHT), _lcd(lcd), _front(nullptr),
+      _phase(0), _shownPlane(0xFF), _running(false), _period(0), _next(0),
+      _subframes(0), _overruns(0), _maxUs(0)
+#if defined(ESP32)
+      ,
+      _timer(nullptr), _mutex(nullptr)
+#endif
+{
+    memset(_altX0, 0xFF, sizeof(_altX0));
+    memset(_altX1, 0x00, sizeof(_altX1));
+    memset(_freshX0, 0xFF, sizeof(_freshX0));
+    memset(_freshX1, 0x00, sizeof(_freshX1));
+}
+
+/**
+ * @brief 析构函数
+ */
+ST7567_Grayscale::~ST7567_Grayscale()
+{
+    end();
+#if defined(ESP32)
+    if (_mutex != nullptr)
+    {
+        vSemaphoreDelete(_mutex);
+        _mutex = nullptr;
+    }
+#endif
+    if (_front != nullptr)
+    {
+        delete[] _front;
+        _front = nullptr;
+    }
+}
+
+/**
+ * @brief 开始灰度显示
+ * @param subframeHz 子帧频率
+ * @return true:启动成功
+ */
+bool ST7567_Grayscale::begin(uint16_t subframeHz)
+{
+    if (_running)
+        return true;
+    if (_lcd.isPageMode())
+        return false;
+
+    if (subframeHz < 30)
+        subframeHz = 30;
+    if (subframeHz > 1000)
+        subframeHz = 1000;
+    _period = 1000000UL / subframeHz;
+
+    if (_front == nullptr)
+    {
+        _front = new uint8_t[2 * ST7567_LCD::FRAME_SIZE]();
+    }
+
+    // 绘图平面全部复制到显示平面，第一个子帧发送整屏
+    _lsb.markDirtyPages(0xFF);
+    _msb.markDirtyPages(0xFF);
+    present();
+    memset(_freshX0, 0, sizeof(_freshX0));
+    memset(_freshX1, ST7567_LCD::LCD_WIDTH - 1, sizeof(_freshX1));
+
+    _phase = 0;
+    _shownPlane = 0xFF;
+    _subframes = 0;
+    _overruns = 0;
+    _maxUs = 0;
+
+    _lcd.waitFlush();
+    _running = true;
+
+#if defined(ESP32)
+    if (_mutex == nullptr)
+    {
+        _mutex = xSemaphoreCreateMutex();
+    }
+    const esp_timer_create_args_t args = {
+        .callback = timerCallback,
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "st7567_gray",
+        .skip_unhandled_events = true,
+    };
+    if (_mutex == nullptr || esp_timer_create(&args, &_timer) != ESP_OK ||
+        esp_timer_start_periodic(_timer, _period) != ESP_OK)
+    {
+        end();
+        return false;
+    }
+#else
+    _next = micros();
+#endif
+    return true;
+}
+
+/**
+ * @brief 停止灰度显示
+ *
+ * 显示RAM已被子帧改写，影子缓冲区标记为无效，下次display()整帧发送。
+ * esp_timer_stop()不等待已派发的回调：运行标志在锁内清除，之后进入的回调直接返回；
+ * 互斥锁留到析构时删除，避免回调还在等锁时被释放
+ */
+void ST7567_Grayscale::end()
+{
+    lock(); // 等待正在执行的子帧结束
+    bool wasRunning = _running;
+    _running = false;
+    unlock();
+
+#if defined(ESP32)
+    if (_timer != nullptr)
+    {
+        esp_timer_stop(_timer);
+        esp_timer_delete(_timer);
+        _timer = nullptr;
+    }
+#endif
+
+    if (wasRunning)
+    {
+        _lcd.invalidateShadow();
+    }
+}
+
+/**
+ * @brief 显示平面加锁
+ */
+void ST7567_Grayscale::lock()
+{
+#if defined(ESP32)
+    if (_mutex != nullptr)
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+#endif
+}
+
+/**
+ * @brief 显示平面解锁
+ */
+void ST7567_Grayscale::unlock()
+{
+#if defined(ESP32)
+    if (_mutex != nullptr)
+        xSemaphoreGive(_mutex);
+#endif
+}
+
+#if defined(ESP32)
+/**
+ * @brief esp_timer回调（esp_timer任务上下文，可以使用SPI）
+ */
+void ST7567_Grayscale::timerCallback(void *arg)
+{
+    static_cast<ST7567_Grayscale *>(arg)->subframe();
+}
+#endif
+
+/**
+ * @brief 轮询驱动子帧
+ * @return true:本次调用输出了一个子帧
+ *
+ * 节拍按周期累加；落后超过一个周期时重新对齐，不连续补发（补发会打乱占空比）
+ */
+bool ST7567_Grayscale::tick()
+{
+#if defined(ESP32)
+    return false;
+#else
+    if (!_running)
+        return false;
+
+    uint32_t now = micros();
+    if ((int32_t)(now - _next) < 0)
+        return false;
+
+    _next += _period;
+    if ((int32_t)(now - _next) >= 0)
+    {
+        _next = now + _period;
+    }
+    subframe();
+    return true;
+#endif
+}
+
+/**
+ * @brief 输出一个子帧
+ *
+ * 显示平面与上一子帧不同时发送两平面不同的列区间，相同时（高位平面的第2个子帧）不发送；
+ * 两种情况都附带提交后变化的列区间。各页在一次CS有效期内发送
+ */
+void ST7567_Grayscale::subframe()
+{
+    lock();
+    if (!_running)
+    {
+        unlock(); // end()之后才执行的回调
+        return;
+    }
+
+    uint32_t start = micros();
+    uint8_t plane = PHASE_PLANE[_phase];
+    bool switched = plane != _shownPlane;
+    const uint8_t *source = _front + plane * ST7567_LCD::FRAME_SIZE;
+
+    if (_lcd._displayEnabled)
+    {
+        _lcd.beginBatch();
+        for (uint8_t page = 0; page < ST7567_LCD::PAGE_COUNT; page++)
+        {
+            uint8_t x0 = _freshX0[page];
+            uint8_t x1 = _freshX1[page];
+            if (switched)
+            {
+                x0 = min(x0, _altX0[page]);
+                x1 = max(x1, _altX1[page]);
+            }
+            if (x0 > x1)
+                continue;
+
+            _lcd.writePage(page, x0, &source[page * ST7567_LCD::LCD_WIDTH + x0], x1 - x0 + 1);
+        }
+        _lcd.endBatch();
+    }
+
+    memset(_freshX0, 0xFF, sizeof(_freshX0));
+    memset(_freshX1, 0x00, sizeof(_freshX1));
+    _shownPlane = plane;
+    _phase = (_phase + 1) % PHASE_COUNT;
+    _subframes++;
+
+    uint32_t elapsed = micros() - start;
+    if (elapsed > _maxUs)
+        _maxUs = elapsed;
+    if (elapsed > _period)
+        _overruns++;
+
+    unlock();
+}
+
+/**
+ * @brief 提交绘图平面
+ *
+ * 只处理绘图平面上被修改的页：逐列比较得到变化区间（下一子帧发送），
+ * 复制到显示平面后重新计算两平面不同的列区间
+ */
+void ST7567_Grayscale::present()
+{
+    if (_front == nullptr)
+        return;
+
+    uint8_t pages = _lsb.getDirtyPages() | _msb.getDirtyPages();
+    if (pages == 0)
+        return;
+
+    lock();
+    for (uint8_t page = 0; page < ST7567_LCD::PAGE_COUNT; page++)
+    {
+        if (!(pages & (1 << page)))
+            continue;
+
+        uint16_t offset = page * ST7567_LCD::LCD_WIDTH;
+        const uint8_t *lsb = _lsb.getBuffer() + offset;
+        const uint8_t *msb = _msb.getBuffer() + offset;
+        uint8_t *frontLsb = _front + offset;
+        uint8_t *frontMsb = _front + ST7567_LCD::FRAME_SIZE + offset;
+
+        uint8_t altX0 = 0xFF;
+        uint8_t altX1 = 0x00;
+        for (uint8_t x = 0; x < ST7567_LCD::LCD_WIDTH; x++)
+        {
+            if (lsb[x] != frontLsb[x] || msb[x] != frontMsb[x])
+            {
+                if (x < _freshX0[page])
+                    _freshX0[page] = x;
+                if (x > _freshX1[page])
+                    _freshX1[page] = x;
+                frontLsb[x] = lsb[x];
+                frontMsb[x] = msb[x];
+            }
+            if (lsb[x] != msb[x])
+            {
+                if (altX0 == 0xFF)
+                    altX0 = x;
+                altX1 = x;
+            }
+        }
+        _altX0[page] = altX0;
+        _altX1[page] = altX1;
+    }
+    unlock();
+
+    _lsb.clearDirty();
+    _msb.clearDirty();
+}
+
+/**
+ * @brief 设置旋转
+ * @param r 旋转0-3
+ *
+ * 绘图函数直接转发给两个位平面，由位平面映射到物理坐标
+ */
+void ST7567_Grayscale::setRotation(uint8_t r)
+{
+    Adafruit_GFX::setRotation(r);
+    _lsb.setRotation(r);
+    _msb.setRotation(r);
+}
+
+/**
+ * @brief 绘制像素点
+ * @param color 灰度等级0-3
+ */
+void ST7567_Grayscale::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    _lsb.drawPixel(x, y, (color & 1) ? ST7567_WHITE : ST7567_BLACK);
+    _msb.drawPixel(x, y, (color & 2) ? ST7567_WHITE : ST7567_BLACK);
+}
+
+/**
+ * @brief 绘制水平线（两平面各一次页内核写入）
+ */
+void ST7567_Grayscale::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    _lsb.drawFastHLine(x, y, w, (color & 1) ? ST7567_WHITE : ST7567_BLACK);
+    _msb.drawFastHLine(x, y, w, (color & 2) ? ST7567_WHITE : ST7567_BLACK);
+}
+
+/**
+ * @brief 绘制垂直线
+ */
+void ST7567_Grayscale::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    _lsb.drawFastVLine(x, y, h, (color & 1) ? ST7567_WHITE : ST7567_BLACK);
+    _msb.drawFastVLine(x, y, h, (color & 2) ? ST7567_WHITE : ST7567_BLACK);
+}
+
+/**
+ * @brief 填充矩形
+ */
+void ST7567_Grayscale::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    _lsb.fillRect(x, y, w, h, (color & 1) ? ST7567_WHITE : ST7567_BLACK);
+    _msb.fillRect(x, y, w, h, (color & 2) ? ST7567_WHITE : ST7567_BLACK);
+}
+
+/**
+ * @brief 整个表面填充同一灰度
+ */
+void ST7567_Grayscale::fillScreen(uint16_t color)
+{
+    _lsb.fillScreen((color & 1) ? ST7567_WHITE : ST7567_BLACK);
+    _msb.fillScreen((color & 2) ? ST7567_WHITE : ST7567_BLACK);
+}
+
+/**
+ * @brief 读取绘图平面上的像素
+ * @return 灰度等级0-3
+ */
+uint8_t ST7567_Grayscale::getPixel(int16_t x, int16_t y) const
+{
+    return (_msb.getPixel(x, y) ? 2 : 0) | (_lsb.getPixel(x, y) ? 1 : 0);
+}
@@ -0,0 +1,179 @@
+/**
+ * @file ST7567_Grayscale.h
+ * @brief ST7567 时间抖动4级灰度
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 单色屏上用时间抖动（帧PWM）显示4级灰度：
+ * - 绘图表面为两个页格式位平面（低位/高位），灰度 = 高位 × 2 + 低位
+ * - 以固定的子帧频率轮流显示位平面，3相调度1-1-2：低位平面1个子帧、高位平面2个子帧，
+ *   像素点亮时间占比为 灰度/3（0、1/3、2/3、1）
+ * - 子帧由定时器驱动（ESP32为esp_timer周期回调，其他平台在loop()中调用tick()），
+ *   占空比不受应用绘制耗时影响
+ * - 只发送需要发送的列：平面切换时发送两平面不同的列区间，两平面相同的页
+ *   （纯黑/纯白内容）在内容变化后只发送一次；高位平面连续的两个子帧之间不传输
+ *
+ * 绘制与显示分离：应用在绘图平面上绘制，present()把绘图平面复制到显示平面并计算
+ * 各页需要发送的列区间，子帧只读取显示平面。
+ *
+ * 使用示例：
+ * @code
+ * ST7567_LCD lcd(CS_PIN, RST_PIN, DC_PIN);
+ * ST7567_Grayscale gray(lcd);
+ *
+ * void setup() {
+ *     lcd.begin();
+ *     gray.begin(180); // 180Hz子帧，灰度周期60Hz
+ *     for (uint8_t i = 0; i < 4; i++)
+ *         gray.fillRect(i * 32, 0, 32, 64, i); // 4级灰阶条
+ *     gray.present();
+ * }
+ *
+ * void loop() {
+ *     gray.tick(); // ESP32上由定时器驱动，这里为空操作
+ * }
+ * @endcode
+ *
+ * @note 运行期间子帧直接写显示RAM，不要再调用驱动的刷新函数；end()后调用display()恢复单色画面。
+ * 子帧频率受整帧传输时间限制（硬件SPI 8MHz时约1.1ms），频率过高时记为超时。
+ * 运行期间不支持页模式。
+ */
+
+#ifndef __ST7567_GRAYSCALE_H
+#define __ST7567_GRAYSCALE_H
+
+#include "ST7567_LCD.h"
+#include "ST7567_Surface.h"
+
+#if defined(ESP32)
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// 灰度等级
+#define ST7567_GRAY_BLACK 0 ///< 熄灭
+#define ST7567_GRAY_DARK 1  ///< 1/3亮度
+#define ST7567_GRAY_LIGHT 2 ///< 2/3亮度
+#define ST7567_GRAY_WHITE 3 ///< 全亮
+
+class ST7567_Grayscale : public Adafruit_GFX
+{
+public:
+    static const uint8_t PHASE_COUNT = 3; ///< 每个灰度周期的子帧数
+
+    /**
+     * @brief 构造函数
+     * @param lcd 显示屏驱动（需已调用begin()）
+     */
+    ST7567_Grayscale(ST7567_LCD &lcd);
+
+    /**
+     * @brief 析构函数 - 停止子帧调度并释放显示平面
+     */
+    ~ST7567_Grayscale();
+
+    /**
+     * @brief 开始灰度显示
+     * @param subframeHz 子帧频率（灰度周期为其1/3），范围30-1000
+     * @return true:启动成功
+     *
+     * 第一个子帧发送整屏；ESP32上创建esp_timer周期定时器
+     */
+    bool begin(uint16_t subframeHz = 180);
+
+    /**
+     * @brief 停止灰度显示（之后调用lcd.display()恢复单色画面）
+     */
+    void end();
+
+    /**
+     * @brief 是否运行中
+     */
+    bool isRunning() const { return _running; }
+
+    /**
+     * @brief 轮询驱动子帧（非ESP32平台在loop()中尽量频繁地调用）
+     * @return true:本次调用输出了一个子帧
+     *
+     * ESP32上子帧由定时器驱动，本函数直接返回false
+     */
+    bool tick();
+
+    /**
+     * @brief 提交绘图平面（复制到显示平面，下一子帧起显示）
+     *
+     * 只在子帧传输间隙复制（ESP32上与定时器回调互斥，最多等待一次传输）
+     */
+    void present();
+
+    /**
+     * @brief 设置旋转（同时作用于两个位平面，映射与驱动相同）
+     * @param r 旋转0-3
+     */
+    void setRotation(uint8_t r) override;
+
+    // 绘图（颜色为灰度等级0-3，坐标受setRotation()影响）
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+
+    /**
+     * @brief 读取绘图平面上的像素
+     * @return 灰度等级0-3（越界返回0）
+     */
+    uint8_t getPixel(int16_t x, int16_t y) const;
+
+    /**
+     * @brief 获取位平面（页格式，可直接写入后调用present()）
+     * @param plane 0:低位, 1:高位
+     */
+    ST7567_Surface &getPlane(uint8_t plane) { return plane ? _msb : _lsb; }
+
+    uint32_t getSubframes() const { return _subframes; } ///< 已输出的子帧数
+    uint32_t getOverruns() const { return _overruns; }   ///< 传输超过子帧周期的次数
+    uint32_t getMaxSubframeUs() const { return _maxUs; } ///< 最长子帧传输时间（微秒）
+
+private:
+    /**
+     * @brief 输出一个子帧
+     */
+    void subframe();
+
+#if defined(ESP32)
+    static void timerCallback(void *arg);
+#endif
+
+    /**
+     * @brief 显示平面互斥（ESP32定时器回调与present()之间）
+     */
+    void lock();
+    void unlock();
+
+    ST7567_LCD &_lcd;               ///< 显示屏驱动
+    ST7567_Surface _lsb;            ///< 绘图平面：低位
+    ST7567_Surface _msb;            ///< 绘图平面：高位
+    uint8_t *_front;                ///< 显示平面（低位、高位各FRAME_SIZE字节）
+    uint8_t _altX0[ST7567_LCD::PAGE_COUNT];   ///< 两平面不同的起始列
+    uint8_t _altX1[ST7567_LCD::PAGE_COUNT];   ///< 两平面不同的结束列
+    uint8_t _freshX0[ST7567_LCD::PAGE_COUNT]; ///< 提交后变化、尚未发送的起始列
+    uint8_t _freshX1[ST7567_LCD::PAGE_COUNT]; ///< 提交后变化、尚未发送的结束列
+    uint8_t _phase;                 ///< 下一个子帧的相位
+    uint8_t _shownPlane;            ///< 显示RAM中当前的平面
+    bool _running;                  ///< 运行中
+    uint32_t _period;               ///< 子帧周期（微秒）
+    uint32_t _next;                 ///< 下一子帧时间（轮询模式）
+    uint32_t _subframes;            ///< 已输出的子帧数
+    uint32_t _overruns;             ///< 超时次数
+    uint32_t _maxUs;                ///< 最长子帧传输时间
+
+#if defined(ESP32)
+    esp_timer_handle_t _timer;      ///< 子帧定时器
+    SemaphoreHandle_t _mutex;       ///< 显示平面互斥锁
+#endif
+};
+
+#endif // __ST7567_GRAYSCALE_H
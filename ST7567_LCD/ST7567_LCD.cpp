@@ -8,12 +8,38 @@
  * 主要优化特性：
  * - 显示刷新性能优化（全屏/局部刷新）
  * - 性能统计和帧率测试
- * - 智能刷新策略（根据区域大小自动选择）
- * - 双缓冲支持
+ * - 运行时性能指标（传输字节、引脚翻转、刷新耗时分布、绘图调用计数），可输出CSV
+ * - 智能刷新策略（自校准代价模型选择局部/合并/全屏刷新）
+ * - 脏区跟踪增量刷新
+ * - 影子缓冲区差分刷新
+ * - 异步刷新（传输引擎接口，ESP32 DMA实现）
+ * - 常驻双缓冲（指针交换，无堆操作）
+ * - 寄存器级软件SPI
+ * - 命令/数据批次传输（单次CS有效期，仅在边界切换DC）
+ * - 内置字体页格式快速文本绘制
+ * - 行优先位图8x8转置块传输
+ * - 页模式逐页渲染（128字节页缓冲区）
+ * - 直线/圆/三角形/圆角矩形按跨度光栅化（页内竖直游程一次写入）
  * - 内存使用优化
  */
 
 #include "ST7567_LCD.h"
+#include "ST7567_PageKernels.h"
+
+#include <glcdfont.c> // Adafruit_GFX内置5x7字体（列字节，LSB在上）
+
+#if defined(ESP32)
+#include <soc/gpio_reg.h>
+#endif
+
+#ifndef _swap_int16_t
+#define _swap_int16_t(a, b) \
+    {                       \
+        int16_t t = a;      \
+        a = b;              \
+        b = t;              \
+    }
+#endif
 
 /**
  * @brief 初始化命令序列
@@ -43,6 +69,33 @@ static const uint8_t init_cmds[] = {
  * @param frequency SPI时钟频率
  */
 ST7567_LCD::ST7567_LCD(int8_t cs, int8_t rst, int8_t dc, SPIClass &spi, uint32_t frequency)
+    : ST7567_LCD(nullptr, cs, rst, dc, spi, frequency)
+{
+}
+
+/**
+ * @brief 软件SPI构造函数（向后兼容）
+ * @param cs 片选引脚
+ * @param rst 复位引脚
+ * @param dc 数据/命令选择引脚
+ * @param sclk 时钟引脚
+ * @param mosi 数据输入引脚
+ */
+ST7567_LCD::ST7567_LCD(int8_t cs, int8_t rst, int8_t dc, int8_t sclk, int8_t mosi)
+    : ST7567_LCD(nullptr, cs, rst, dc, sclk, mosi)
+{
+}
+
+/**
+ * @brief 硬件SPI构造函数（指定帧缓冲区）
+ * @param buffer 静态帧缓冲区（nullptr时从堆分配）
+ * @param cs 片选引脚
+ * @param rst 复位引脚
+ * @param dc 数据/命令选择引脚
+ * @param spi SPI实例引用
+ * @param frequency SPI时钟频率
+ */
+ST7567_LCD::ST7567_LCD(uint8_t *buffer, int8_t cs, int8_t rst, int8_t dc, SPIClass &spi, uint32_t frequency)
     : Adafruit_GFX(LCD_WIDTH, LCD_HEIGHT), _spi(&spi), _spiFrequency(frequency)
 {
     _cs = cs;
@@ -50,30 +103,54 @@ ST7567_LCD::ST7567_LCD(int8_t cs, int8_t rst, int8_t dc, SPIClass &spi, uint32_t
     _dc = dc;
     _sclk = _mosi = -1; // 硬件SPI时时钟和数据引脚为-1
     _useHardwareSPI = true;
+    _fastSoftSPI = false;
 
     // 配置SPI参数：频率、位序、模式
     _spiSettings = SPISettings(_spiFrequency, MSBFIRST, SPI_MODE0);
 
-    // 分配帧缓冲区内存并初始化为0
-    frameBuffer = new uint8_t[FRAME_SIZE]();
+    // 使用静态缓冲区或分配帧缓冲区内存，并初始化为0
+    initFrameBuffer(buffer);
 
     // 初始化状态变量
     _displayEnabled = true;
     _lastStatTime = 0;
     _frameCount = 0;
     _fps = 0;
+    _shadowBuffer = nullptr;
+    _shadowValid = false;
+    _initialized = false;
+    _batchDepth = 0;
+    _dcState = -1;
+    _flushEngine = nullptr;
+    _asyncBuffer = nullptr;
+    _frontBuffer = nullptr;
+    _swapMode = SWAP_COPY;
+    _flushCallback = nullptr;
+    _flushCallbackContext = nullptr;
+    _flushCostFixed = false;
+    _lastStrategy = FLUSH_NONE;
+    initFlushCost();
+    resetMetrics();
+    _pageMode = false;
+    _bufferPage = 0;
+    _clipY0 = 0;
+    _clipY1 = LCD_HEIGHT - 1;
+    _pageBuffers[0] = _pageBuffers[1] = nullptr;
+    _ownBuffer = nullptr;
+    clearDirty();
 }
 
 /**
- * @brief 软件SPI构造函数（向后兼容）
+ * @brief 软件SPI构造函数（指定帧缓冲区）
+ * @param buffer 静态帧缓冲区（nullptr时从堆分配）
  * @param cs 片选引脚
  * @param rst 复位引脚
  * @param dc 数据/命令选择引脚
  * @param sclk 时钟引脚
  * @param mosi 数据输入引脚
  */
-ST7567_LCD::ST7567_LCD(int8_t cs, int8_t rst, int8_t dc, int8_t sclk, int8_t mosi)
-    : Adafruit_GFX(LCD_WIDTH, LCD_HEIGHT), _spi(nullptr)
+ST7567_LCD::ST7567_LCD(uint8_t *buffer, int8_t cs, int8_t rst, int8_t dc, int8_t sclk, int8_t mosi)
+    : Adafruit_GFX(LCD_WIDTH, LCD_HEIGHT), _spi(nullptr), _spiFrequency(0)
 {
     _cs = cs;
     _rst = rst;
@@ -82,13 +159,75 @@ ST7567_LCD::ST7567_LCD(int8_t cs, int8_t rst, int8_t dc, int8_t sclk, int8_t mos
     _mosi = mosi;
     // 如果sclk或mosi为-1，则使用硬件SPI
     _useHardwareSPI = (sclk == -1 || mosi == -1);
-    frameBuffer = new uint8_t[FRAME_SIZE]();
+    initFrameBuffer(buffer);
+
+    // 软件SPI：预先计算GPIO寄存器地址和掩码
+    _fastSoftSPI = false;
+    if (!_useHardwareSPI)
+    {
+        initSoftSPIPort();
+    }
 
     // 初始化状态变量
     _displayEnabled = true;
     _lastStatTime = 0;
     _frameCount = 0;
     _fps = 0;
+    _shadowBuffer = nullptr;
+    _shadowValid = false;
+    _initialized = false;
+    _batchDepth = 0;
+    _dcState = -1;
+    _flushEngine = nullptr;
+    _asyncBuffer = nullptr;
+    _frontBuffer = nullptr;
+    _swapMode = SWAP_COPY;
+    _flushCallback = nullptr;
+    _flushCallbackContext = nullptr;
+    _flushCostFixed = false;
+    _lastStrategy = FLUSH_NONE;
+    initFlushCost();
+    resetMetrics();
+    _pageMode = false;
+    _bufferPage = 0;
+    _clipY0 = 0;
+    _clipY1 = LCD_HEIGHT - 1;
+    _pageBuffers[0] = _pageBuffers[1] = nullptr;
+    _ownBuffer = nullptr;
+    clearDirty();
+}
+
+/**
+ * @brief 设置初始帧缓冲区
+ * @param buffer 静态帧缓冲区（nullptr时从堆分配）
+ *
+ * 静态缓冲区（ST7567_LCDT的内联存储或调用者提供的静态数组）不归驱动释放，
+ * 之后页模式切换、换缓冲区时都按此区分
+ */
+void ST7567_LCD::initFrameBuffer(uint8_t *buffer)
+{
+    _staticBuffer = buffer;
+    if (buffer != nullptr)
+    {
+        memset(buffer, 0x00, FRAME_SIZE);
+        frameBuffer = buffer;
+    }
+    else
+    {
+        frameBuffer = new uint8_t[FRAME_SIZE]();
+    }
+}
+
+/**
+ * @brief 释放驱动拥有的整帧缓冲区（静态缓冲区不释放）
+ * @param buffer 缓冲区
+ */
+void ST7567_LCD::releaseFrameBuffer(uint8_t *buffer)
+{
+    if (buffer != nullptr && buffer != _staticBuffer)
+    {
+        delete[] buffer;
+    }
 }
 
 /**
@@ -96,10 +235,41 @@ ST7567_LCD::ST7567_LCD(int8_t cs, int8_t rst, int8_t dc, int8_t sclk, int8_t mos
  */
 ST7567_LCD::~ST7567_LCD()
 {
-    if (frameBuffer != nullptr)
+    // 后台传输可能仍在读取异步缓冲区
+    waitFlush();
+    if (_asyncBuffer != nullptr)
+    {
+        delete[] _asyncBuffer;
+        _asyncBuffer = nullptr;
+    }
+    if (_frontBuffer != nullptr)
+    {
+        releaseFrameBuffer(_frontBuffer); // 双缓冲交换后静态缓冲区可能在前台
+        _frontBuffer = nullptr;
+    }
+    if (_pageMode)
+    {
+        frameBuffer = nullptr; // 页模式下指向_pageBuffers
+    }
+    if (_ownBuffer != nullptr)
+    {
+        frameBuffer = _ownBuffer; // 外部缓冲区不归驱动释放
+        _ownBuffer = nullptr;
+    }
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        if (_pageBuffers[i] != nullptr)
+        {
+            delete[] _pageBuffers[i];
+            _pageBuffers[i] = nullptr;
+        }
+    }
+    releaseFrameBuffer(frameBuffer);
+    frameBuffer = nullptr;
+    if (_shadowBuffer != nullptr)
     {
-        delete[] frameBuffer;
-        frameBuffer = nullptr;
+        delete[] _shadowBuffer;
+        _shadowBuffer = nullptr;
     }
 }
 
@@ -122,8 +292,12 @@ void ST7567_LCD::begin(uint8_t contrast)
     pinMode(_dc, OUTPUT);
     pinMode(_rst, OUTPUT);
 
-    // 根据模式初始化SPI
-    if (_useHardwareSPI && _spi)
+    // 根据模式初始化SPI（传输引擎接管总线时由引擎初始化）
+    if (_flushEngine != nullptr)
+    {
+        _flushEngine->begin();
+    }
+    else if (_useHardwareSPI && _spi)
     {
         _spi->begin();
         Serial.println("ST7567: Hardware SPI initialized");
@@ -132,6 +306,7 @@ void ST7567_LCD::begin(uint8_t contrast)
     {
         pinMode(_sclk, OUTPUT);
         pinMode(_mosi, OUTPUT);
+        digitalWrite(_sclk, LOW); // SPI模式0：时钟空闲为低
         Serial.println("ST7567: Software SPI initialized");
     }
 
@@ -146,12 +321,27 @@ void ST7567_LCD::begin(uint8_t contrast)
     // 初始化片选信号
     digitalWrite(_cs, HIGH);
 
-    // 发送初始化命令并设置参数
+    // 发送初始化命令并设置参数（控制器RAM内容未知，影子缓冲区失效）
+    _shadowValid = false;
     initDisplay();
     setContrast(contrast);
     clearDisplay();
-    display(); // 首次显示清空屏幕
+    if (_pageMode)
+    {
+        clearScreen(0x00); // 页模式没有整帧缓冲区，直接清空显示RAM
+    }
+    else
+    {
+        display(); // 首次显示清空屏幕
+    }
+
+    // 测量实际的命令/数据开销，供refreshRegion()选择刷新策略
+    if (!_flushCostFixed)
+    {
+        calibrateFlushCost();
+    }
 
+    _initialized = true;
     Serial.println("ST7567: Display initialized successfully");
 }
 
@@ -163,7 +353,10 @@ void ST7567_LCD::begin(uint8_t contrast)
  */
 void ST7567_LCD::spiBeginTransaction()
 {
-    if (_useHardwareSPI && _spi)
+    // 同步写入不能与后台异步传输交错
+    waitFlush();
+
+    if (_flushEngine == nullptr && _useHardwareSPI && _spi)
     {
         _spi->beginTransaction(_spiSettings);
     }
@@ -176,7 +369,7 @@ void ST7567_LCD::spiBeginTransaction()
  */
 void ST7567_LCD::spiEndTransaction()
 {
-    if (_useHardwareSPI && _spi)
+    if (_flushEngine == nullptr && _useHardwareSPI && _spi)
     {
         _spi->endTransaction();
     }
@@ -187,123 +380,344 @@ void ST7567_LCD::spiEndTransaction()
  *
  * 发送初始化命令序列到ST7567控制器
  * 配置显示参数和控制器工作模式
+ *
+ * 整个序列在一次CS有效期内发送（原先每条命令单独切换CS，共17次）
  */
 void ST7567_LCD::initDisplay()
 {
-    spiBeginTransaction();
+    writeCommands(init_cmds, sizeof(init_cmds));
+}
 
-    // 逐条发送初始化命令
-    for (size_t i = 0; i < sizeof(init_cmds); i++)
-    {
-        writeCommand(init_cmds[i]);
-    }
+/**
+ * @brief 批量发送命令
+ * @param cmds 命令字节数组
+ * @param len 命令字节数
+ *
+ * 传输流程：
+ * 1. 开始SPI事务，拉低CS
+ * 2. DC低电平（命令模式）连续发送所有命令字节
+ * 3. 拉高CS，结束SPI事务
+ *
+ * 可在beginBatch()/endBatch()之间调用，此时并入当前批次
+ */
+void ST7567_LCD::writeCommands(const uint8_t *cmds, size_t len)
+{
+    if (len == 0)
+        return;
 
-    spiEndTransaction();
+    beginBatch();
+    batchCommands(cmds, len);
+    endBatch();
 }
 
 /**
- * @brief 写入命令字节
- * @param cmd 命令字节
+ * @brief 开始命令/数据批次
  *
- * 传输流程：
- * 1. 设置DC为低电平（命令模式）
- * 2. 拉低CS片选信号
- * 3. 通过SPI发送命令字节
- * 4. 拉高CS片选信号
+ * 批次期间CS保持低电平，只在命令/数据边界切换DC。
+ * 支持嵌套，最外层的endBatch()才拉高CS
  */
-void ST7567_LCD::writeCommand(uint8_t cmd)
+void ST7567_LCD::beginBatch()
 {
-    digitalWrite(_dc, LOW); // 命令模式
-    digitalWrite(_cs, LOW); // 使能器件
+    if (_batchDepth++ == 0)
+    {
+        spiBeginTransaction();
+        digitalWrite(_cs, LOW); // 使能器件
+        ST7567_METRIC(_metrics.csToggles++);
+        _dcState = -1;          // DC状态未知，第一个分段必定设置
+    }
+}
 
-    if (_useHardwareSPI && _spi)
+/**
+ * @brief 结束命令/数据批次
+ */
+void ST7567_LCD::endBatch()
+{
+    if (_batchDepth == 0)
+        return;
+
+    if (--_batchDepth == 0)
     {
-        _spi->transfer(cmd); // 硬件SPI传输
+        digitalWrite(_cs, HIGH); // 禁用器件
+        ST7567_METRIC(_metrics.csToggles++);
+        spiEndTransaction();
     }
-    else
+}
+
+/**
+ * @brief 在批次中发送命令字节
+ * @param cmds 命令字节数组
+ * @param len 字节数
+ */
+void ST7567_LCD::batchCommands(const uint8_t *cmds, size_t len)
+{
+    setDCMode(LOW);
+    spiWrite(cmds, len);
+    ST7567_METRIC(_metrics.commandBytes += len);
+}
+
+/**
+ * @brief 在批次中发送显示数据
+ * @param data 数据指针
+ * @param len 字节数
+ */
+void ST7567_LCD::batchData(const uint8_t *data, size_t len)
+{
+    setDCMode(HIGH);
+    spiWrite(data, len);
+}
+
+/**
+ * @brief 在批次中重复发送同一数据字节
+ * @param pattern 填充字节
+ * @param count 重复次数
+ */
+void ST7567_LCD::batchPattern(uint8_t pattern, size_t count)
+{
+    setDCMode(HIGH);
+    spiWritePattern(pattern, count);
+}
+
+/**
+ * @brief 设置DC电平（与当前电平相同时不操作引脚）
+ * @param level LOW:命令, HIGH:数据
+ */
+void ST7567_LCD::setDCMode(uint8_t level)
+{
+    if (_dcState != (int8_t)level)
     {
-        shiftOut(_mosi, _sclk, MSBFIRST, cmd); // 软件SPI传输
+        digitalWrite(_dc, level);
+        _dcState = level;
+        ST7567_METRIC(_metrics.dcToggles++);
     }
+}
 
-    digitalWrite(_cs, HIGH); // 禁用器件
+/**
+ * @brief 写入一页中的连续列数据（含地址命令）
+ * @param page 页地址（0-7）
+ * @param col 起始列地址
+ * @param data 数据指针
+ * @param len 数据长度
+ *
+ * 需在批次中调用：
+ * 1. 命令模式发送3字节地址命令（页地址、列高4位、列低4位）
+ * 2. 数据模式连续发送数据
+ *
+ * ST7567显示内存组织：8页 × 132列（实际显示128列），页地址不会自动递增
+ */
+void ST7567_LCD::writePage(uint8_t page, uint8_t col, const uint8_t *data, size_t len)
+{
+    const uint8_t addr[3] = {
+        (uint8_t)(0xB0 + page),       // 设置页地址（0xB0-0xB7）
+        (uint8_t)(0x10 + (col >> 4)), // 设置列地址高4位（0x10-0x1F）
+        (uint8_t)(0x00 + (col & 0xF)) // 设置列地址低4位（0x00-0x0F）
+    };
+
+    batchCommands(addr, sizeof(addr));
+    batchData(data, len);
 }
 
 /**
- * @brief 写入单字节数据
- * @param data 数据字节
+ * @brief 块传输原始字节（不操作CS/DC）
+ * @param data 数据指针
+ * @param len 数据长度
  *
- * 传输流程与writeCommand类似，但DC引脚为高电平（数据模式）
+ * 传输引擎接管总线时通过引擎同步发送；硬件SPI：
+ * - ESP32/ESP8266使用writeBytes()，一次调用填满SPI FIFO，避免逐字节往返
+ * - 其他平台分块拷贝到栈缓冲区后使用transfer(buf, len)（该接口会覆盖缓冲区）
  */
-void ST7567_LCD::writeData(uint8_t data)
+void ST7567_LCD::spiWrite(const uint8_t *data, size_t len)
 {
-    digitalWrite(_dc, HIGH); // 数据模式
-    digitalWrite(_cs, LOW);  // 使能器件
+    ST7567_METRIC(_metrics.bytesSent += len);
+    spiWriteRaw(data, len);
+}
 
-    if (_useHardwareSPI && _spi)
+/**
+ * @brief 块传输原始字节（不计入性能指标）
+ * @param data 数据指针
+ * @param len 数据长度
+ */
+void ST7567_LCD::spiWriteRaw(const uint8_t *data, size_t len)
+{
+    if (_flushEngine != nullptr)
+    {
+        _flushEngine->writeBlocking(data, len);
+    }
+    else if (_useHardwareSPI && _spi)
     {
-        _spi->transfer(data); // 硬件SPI传输
+#if defined(ESP32) || defined(ESP8266)
+        _spi->writeBytes(data, len);
+#else
+        uint8_t chunk[32];
+        while (len > 0)
+        {
+            size_t n = len < sizeof(chunk) ? len : sizeof(chunk);
+            memcpy(chunk, data, n);
+            _spi->transfer(chunk, n);
+            data += n;
+            len -= n;
+        }
+#endif
     }
     else
     {
-        shiftOut(_mosi, _sclk, MSBFIRST, data); // 软件SPI传输
+        for (size_t i = 0; i < len; i++)
+        {
+            softSPIWriteByte(data[i]);
+        }
     }
-
-    digitalWrite(_cs, HIGH); // 禁用器件
 }
 
 /**
- * @brief 批量写入数据
- * @param data 数据缓冲区指针
- * @param len 数据长度
+ * @brief 重复发送同一字节（不操作CS/DC）
+ * @param pattern 填充字节
+ * @param count 重复次数
  *
- * 优化传输效率的方法：
- * - 减少CS引脚切换次数
- * - 硬件SPI下可连续传输多个字节
- * - 适合大量数据的连续写入
+ * ESP32/ESP8266使用writePattern()由驱动直接填充FIFO，不需要源数据缓冲区
  */
-void ST7567_LCD::writeDataBulk(const uint8_t *data, size_t len)
+void ST7567_LCD::spiWritePattern(uint8_t pattern, size_t count)
 {
-    if (len == 0)
-        return;
-
-    digitalWrite(_dc, HIGH); // 数据模式
-    digitalWrite(_cs, LOW);  // 使能器件
+    ST7567_METRIC(_metrics.bytesSent += count);
 
-    if (_useHardwareSPI && _spi)
+    if (_flushEngine != nullptr)
     {
-        // 硬件SPI批量传输（效率更高）
-        for (size_t i = 0; i < len; i++)
+        uint8_t chunk[32];
+        memset(chunk, pattern, sizeof(chunk));
+        while (count > 0)
+        {
+            size_t n = count < sizeof(chunk) ? count : sizeof(chunk);
+            _flushEngine->writeBlocking(chunk, n);
+            count -= n;
+        }
+    }
+    else if (_useHardwareSPI && _spi)
+    {
+#if defined(ESP32) || defined(ESP8266)
+        _spi->writePattern(&pattern, 1, count);
+#else
+        uint8_t chunk[32];
+        while (count > 0)
         {
-            _spi->transfer(data[i]);
+            size_t n = count < sizeof(chunk) ? count : sizeof(chunk);
+            memset(chunk, pattern, n);
+            _spi->transfer(chunk, n);
+            count -= n;
         }
+#endif
     }
     else
     {
-        // 软件SPI逐个传输
-        for (size_t i = 0; i < len; i++)
+        for (size_t i = 0; i < count; i++)
         {
-            shiftOut(_mosi, _sclk, MSBFIRST, data[i]);
+            softSPIWriteByte(pattern);
         }
     }
+}
 
-    digitalWrite(_cs, HIGH); // 禁用器件
+/**
+ * @brief 缓存软件SPI引脚的GPIO置位/清零寄存器和掩码
+ *
+ * 平台实现：
+ * - ESP32：GPIO_OUT_W1TS/W1TC（0-31脚），GPIO_OUT1_W1TS/W1TC（32脚以上）
+ * - ESP8266：GPOS/GPOC（0-15脚，GPIO16不在该寄存器组）
+ * - 其他平台：保持shiftOut()
+ *
+ * 置位/清零寄存器只影响掩码中的位，无需读-改-写，也不会干扰同端口的其他引脚
+ */
+void ST7567_LCD::initSoftSPIPort()
+{
+    _fastSoftSPI = false;
+    if (_sclk < 0 || _mosi < 0)
+        return;
+
+#if defined(ESP32)
+    if (_sclk < 32)
+    {
+        _sclkSetReg = (volatile uint32_t *)GPIO_OUT_W1TS_REG;
+        _sclkClrReg = (volatile uint32_t *)GPIO_OUT_W1TC_REG;
+        _sclkMask = 1UL << _sclk;
+    }
+#ifdef GPIO_OUT1_W1TS_REG
+    else
+    {
+        _sclkSetReg = (volatile uint32_t *)GPIO_OUT1_W1TS_REG;
+        _sclkClrReg = (volatile uint32_t *)GPIO_OUT1_W1TC_REG;
+        _sclkMask = 1UL << (_sclk - 32);
+    }
+#else
+    else
+        return;
+#endif
+    if (_mosi < 32)
+    {
+        _mosiSetReg = (volatile uint32_t *)GPIO_OUT_W1TS_REG;
+        _mosiClrReg = (volatile uint32_t *)GPIO_OUT_W1TC_REG;
+        _mosiMask = 1UL << _mosi;
+    }
+#ifdef GPIO_OUT1_W1TS_REG
+    else
+    {
+        _mosiSetReg = (volatile uint32_t *)GPIO_OUT1_W1TS_REG;
+        _mosiClrReg = (volatile uint32_t *)GPIO_OUT1_W1TC_REG;
+        _mosiMask = 1UL << (_mosi - 32);
+    }
+#else
+    else
+        return;
+#endif
+    _fastSoftSPI = true;
+#elif defined(ESP8266)
+    if (_sclk > 15 || _mosi > 15)
+        return;
+    _sclkSetReg = &GPOS;
+    _sclkClrReg = &GPOC;
+    _sclkMask = 1UL << _sclk;
+    _mosiSetReg = &GPOS;
+    _mosiClrReg = &GPOC;
+    _mosiMask = 1UL << _mosi;
+    _fastSoftSPI = true;
+#endif
 }
 
 /**
- * @brief 设置显示地址窗口
- * @param page 页地址（0-7）
- * @param col 列地址（0-131）
+ * @brief 软件SPI发送一个字节
+ * @param b 数据字节
  *
- * ST7567显示内存组织：
- * - 8页（page），每页8行像素
- * - 132列（col），实际显示128列
- * - 地址命令：页地址 + 列地址高4位 + 列地址低4位
+ * SPI模式0、MSB优先：先输出数据位，再产生时钟上升沿（ST7567在上升沿采样）。
+ * 8位完全展开，每位只有3次寄存器写入，无循环和函数调用开销
  */
-void ST7567_LCD::setAddrWindow(uint8_t page, uint8_t col)
+void ST7567_LCD::softSPIWriteByte(uint8_t b)
 {
-    writeCommand(0xB0 + page);        // 设置页地址（0xB0-0xB7）
-    writeCommand(0x10 + (col >> 4));  // 设置列地址高4位（0x10-0x1F）
-    writeCommand(0x00 + (col & 0xF)); // 设置列地址低4位（0x00-0x0F）
+    if (!_fastSoftSPI)
+    {
+        shiftOut(_mosi, _sclk, MSBFIRST, b);
+        return;
+    }
+
+    volatile uint32_t *sclkSet = _sclkSetReg;
+    volatile uint32_t *sclkClr = _sclkClrReg;
+    volatile uint32_t *mosiSet = _mosiSetReg;
+    volatile uint32_t *mosiClr = _mosiClrReg;
+    const uint32_t sclkMask = _sclkMask;
+    const uint32_t mosiMask = _mosiMask;
+
+#define ST7567_SOFT_SPI_BIT(bit)     \
+    if (b & (bit))                   \
+        *mosiSet = mosiMask;         \
+    else                             \
+        *mosiClr = mosiMask;         \
+    *sclkSet = sclkMask;             \
+    *sclkClr = sclkMask;
+
+    ST7567_SOFT_SPI_BIT(0x80)
+    ST7567_SOFT_SPI_BIT(0x40)
+    ST7567_SOFT_SPI_BIT(0x20)
+    ST7567_SOFT_SPI_BIT(0x10)
+    ST7567_SOFT_SPI_BIT(0x08)
+    ST7567_SOFT_SPI_BIT(0x04)
+    ST7567_SOFT_SPI_BIT(0x02)
+    ST7567_SOFT_SPI_BIT(0x01)
+
+#undef ST7567_SOFT_SPI_BIT
 }
 
 /**
@@ -322,530 +736,2229 @@ void ST7567_LCD::setAddrWindow(uint8_t page, uint8_t col)
  * 4. 添加传输完成确认
  *
  * 性能优化：
- * - 全屏刷新：约8ms @ 40MHz SPI
+ * - 全屏刷新：1048字节（1024数据+24地址命令），40MHz SPI线路时间约210us
  * - 局部刷新：根据区域大小按比例减少
  */
 void ST7567_LCD::display()
 {
-    // 检查显示是否使能，避免不必要的刷新
-    if (!_displayEnabled)
+    // 检查显示是否使能，避免不必要的刷新（页模式下由renderPaged()刷新）
+    if (!_displayEnabled || _pageMode)
     {
         return;
     }
 
-    spiBeginTransaction();
+    flushFrame(frameBuffer);
+}
 
-    // 批量传输所有页数据，减少SPI事务开销
-    for (uint8_t page = 0; page < 8; page++)
+/**
+ * @brief 同步刷新指定缓冲区的整帧内容
+ * @param buffer 帧数据（1024字节，页格式）
+ *
+ * 影子缓冲区有效时走差分路径，否则逐页全量发送
+ */
+void ST7567_LCD::flushFrame(const uint8_t *buffer)
+{
+    // 影子缓冲区有效时只发送差异部分
+    if (_shadowBuffer != nullptr && _shadowValid)
     {
-        // 设置当前页地址（页地址 + 列起始地址0）
-        writeCommand(0xB0 + page); // 设置页地址
-        writeCommand(0x10);        // 设置列地址高4位为0
-        writeCommand(0x00);        // 设置列地址低4位为0
-
-        // 批量传输整页数据（128字节）
-        digitalWrite(_dc, HIGH); // 切换到数据模式
-        digitalWrite(_cs, LOW);  // 使能器件
-
-        // 优化：使用指针算术减少索引计算
-        const uint8_t *pageData = &frameBuffer[page * LCD_WIDTH];
+        displayDiff(buffer);
+        return;
+    }
 
-        if (_useHardwareSPI && _spi)
-        {
-            // 硬件SPI优化：减少函数调用次数
-            for (uint16_t i = 0; i < LCD_WIDTH; i++)
-            {
-                _spi->transfer(pageData[i]);
-            }
-        }
-        else
-        {
-            // 软件SPI优化：内联传输逻辑
-            for (uint16_t i = 0; i < LCD_WIDTH; i++)
-            {
-                shiftOut(_mosi, _sclk, MSBFIRST, pageData[i]);
-            }
-        }
+    uint32_t startTime = micros();
 
-        digitalWrite(_cs, HIGH); // 禁用器件
+    // 整帧在一次CS有效期内完成，每页只在地址命令/数据边界切换DC（每帧16次）
+    beginBatch();
+    for (uint8_t page = 0; page < PAGE_COUNT; page++)
+    {
+        writePage(page, 0, &buffer[page * LCD_WIDTH], LCD_WIDTH);
     }
+    endBatch();
 
-    spiEndTransaction();
-
-    // 更新性能统计
-    _frameCount++;
-    uint32_t currentTime = millis();
-    if (currentTime - _lastStatTime >= 1000)
+    // 整屏已同步，更新影子缓冲区并清除脏区记录
+    if (_shadowBuffer != nullptr)
     {
-        _fps = _frameCount;
-        _frameCount = 0;
-        _lastStatTime = currentTime;
+        memcpy(_shadowBuffer, buffer, FRAME_SIZE);
+        _shadowValid = true;
     }
+    clearDirty();
+
+    // 更新性能统计
+    recordFlush(startTime, true);
+    updateFrameStats();
 }
 
 /**
- * @brief 智能局部刷新函数（优化版本）
- * @param x 起始X坐标（0-127）
- * @param y 起始Y坐标（0-63）
- * @param width 刷新区域宽度
- * @param height 刷新区域高度
+ * @brief 异步全屏刷新
+ * @return true:已交给传输引擎在后台发送, false:未设置引擎，已同步刷新
  *
- * 优化特性：
- * 1. 自动边界检查和裁剪
- * 2. 智能页对齐，减少数据传输量
- * 3. 支持跨页区域的连续刷新
- * 4. 添加脏矩形标记，避免重复刷新
+ * 刷新流程：
+ * 1. 等待上一帧传输完成
+ * 2. 将帧缓冲区快照到异步缓冲区（约1KB memcpy，远快于SPI传输）
+ * 3. 通过submitFrame()一次性提交16个分段
+ * 4. 立即返回，应用可继续在frameBuffer中渲染下一帧
  *
- * 适用场景：
- * - 游戏精灵动画更新
- * - 文本光标闪烁
- * - 进度条局部更新
- * - 图表数据刷新
+ * 影子缓冲区、脏区记录和帧率统计按已提交的帧更新
  */
-void ST7567_LCD::refreshRegion(int16_t x, int16_t y, uint16_t width, uint16_t height)
+bool ST7567_LCD::displayAsync()
 {
-    // 边界检查和裁剪
-    if (x >= LCD_WIDTH || y >= LCD_HEIGHT || width == 0 || height == 0)
+    if (!_displayEnabled || _pageMode)
     {
-        return;
+        return false;
     }
 
-    // 裁剪到有效区域
-    int16_t endX = min((int16_t)(x + width - 1), (int16_t)(LCD_WIDTH - 1));
-    int16_t endY = min((int16_t)(y + height - 1), (int16_t)(LCD_HEIGHT - 1));
-
-    if (x < 0)
-        x = 0;
-    if (y < 0)
-        y = 0;
-    width = endX - x + 1;
-    height = endY - y + 1;
-
-    // 计算涉及的页范围（每页8行）
-    uint8_t startPage = y / 8;
-    uint8_t endPage = (y + height - 1) / 8;
-
-    // 如果刷新区域很小，使用全屏刷新可能更快
-    if (width * height < 256)
-    { // 经验阈值：刷新区域小于256像素
+    if (_flushEngine == nullptr)
+    {
         display();
-        return;
+        return false;
     }
 
-    spiBeginTransaction();
+    waitFlush();
 
-    // 逐页刷新指定区域
-    for (uint8_t page = startPage; page <= endPage; page++)
+    if (_asyncBuffer == nullptr)
     {
-        // 设置当前页和列地址
-        setAddrWindow(page, x);
-
-        // 计算该页中需要刷新的字节数
-        uint16_t bytesToSend = width;
-
-        // 批量传输该页的指定列数据
-        writeDataBulk(&frameBuffer[page * LCD_WIDTH + x], bytesToSend);
+        _asyncBuffer = new uint8_t[FRAME_SIZE];
     }
+    memcpy(_asyncBuffer, frameBuffer, FRAME_SIZE);
 
-    spiEndTransaction();
+    if (!submitFrame(_asyncBuffer))
+    {
+        display();
+        return false;
+    }
+    return true;
 }
 
 /**
- * @brief 清空帧缓冲区
+ * @brief 将整帧提交给传输引擎
+ * @param buffer 帧数据（传输完成前不得修改）
+ * @return true:已提交
  *
- * 将帧缓冲区所有字节设置为0，即清空屏幕
- * 注意：此操作只清空缓冲区，需要调用display()才能实际更新显示
+ * 生成8页 × (3字节地址命令 + 128字节数据) 共16个分段并一次性提交
  */
-void ST7567_LCD::clearDisplay()
+bool ST7567_LCD::submitFrame(const uint8_t *buffer)
 {
-    if (frameBuffer != nullptr)
+    uint32_t startTime = micros();
+    ST7567_FlushSegment segments[PAGE_COUNT * 2];
+    for (uint8_t page = 0; page < PAGE_COUNT; page++)
     {
-        memset(frameBuffer, 0x00, FRAME_SIZE);
+        _asyncCmds[page][0] = 0xB0 + page; // 页地址
+        _asyncCmds[page][1] = 0x10;        // 列地址高4位
+        _asyncCmds[page][2] = 0x00;        // 列地址低4位
+
+        segments[page * 2].data = _asyncCmds[page];
+        segments[page * 2].length = ADDR_CMD_BYTES;
+        segments[page * 2].isData = false;
+        segments[page * 2 + 1].data = &buffer[page * LCD_WIDTH];
+        segments[page * 2 + 1].length = LCD_WIDTH;
+        segments[page * 2 + 1].isData = true;
+    }
+
+    if (!_flushEngine->submit(segments, PAGE_COUNT * 2))
+    {
+        return false;
+    }
+
+    // 引擎在后台发送，按已提交的分段计数（CS两个边沿，每页DC两次切换）
+    ST7567_METRIC(_metrics.bytesSent += FULL_FRAME_BYTES);
+    ST7567_METRIC(_metrics.commandBytes += PAGE_COUNT * ADDR_CMD_BYTES);
+    ST7567_METRIC(_metrics.csToggles += 2);
+    ST7567_METRIC(_metrics.dcToggles += PAGE_COUNT * 2);
+
+    if (_shadowBuffer != nullptr)
+    {
+        memcpy(_shadowBuffer, buffer, FRAME_SIZE);
+        _shadowValid = true;
     }
+    clearDirty();
+    recordFlush(startTime, true);
+    updateFrameStats();
+    return true;
 }
 
 /**
- * @brief 快速清屏并刷新（优化版本）
- * @param pattern 填充模式（0x00:全黑, 0xFF:全白, 其他:图案）
+ * @brief 发送整帧，不修改脏区记录和性能统计
+ * @param buffer 帧数据
  *
- * 优化点：
- * - 直接操作显示内存，跳过帧缓冲区
- * - 使用图案填充减少数据传输
- * - 支持快速清屏模式
+ * 后台刷新任务在另一个核心上调用，此时应用核心正在绘制并写入脏区记录和性能指标，
+ * 这里只访问总线、异步地址命令和影子缓冲区（绘图函数不访问这些状态）：
+ * - 有传输引擎且影子缓冲区无效时提交16个分段并等待DMA完成
+ * - 否则直接驱动CS/DC发送（不经过批次计数），影子缓冲区有效时每页只发送变化的列区间
  */
-void ST7567_LCD::clearScreen(uint8_t pattern)
+void ST7567_LCD::sendFrameRaw(const uint8_t *buffer)
 {
-    spiBeginTransaction();
+    bool diff = _shadowBuffer != nullptr && _shadowValid;
 
-    // 直接填充显示内存，避免帧缓冲区操作
-    for (uint8_t page = 0; page < 8; page++)
+    if (_flushEngine != nullptr && !diff)
+    {
+        ST7567_FlushSegment segments[PAGE_COUNT * 2];
+        for (uint8_t page = 0; page < PAGE_COUNT; page++)
+        {
+            _asyncCmds[page][0] = 0xB0 + page;
+            _asyncCmds[page][1] = 0x10;
+            _asyncCmds[page][2] = 0x00;
+
+            segments[page * 2].data = _asyncCmds[page];
+            segments[page * 2].length = ADDR_CMD_BYTES;
+            segments[page * 2].isData = false;
+            segments[page * 2 + 1].data = &buffer[page * LCD_WIDTH];
+            segments[page * 2 + 1].length = LCD_WIDTH;
+            segments[page * 2 + 1].isData = true;
+        }
+
+        if (_flushEngine->submit(segments, PAGE_COUNT * 2))
+        {
+            _flushEngine->wait();
+            if (_shadowBuffer != nullptr)
+            {
+                memcpy(_shadowBuffer, buffer, FRAME_SIZE);
+                _shadowValid = true;
+            }
+            return;
+        }
+    }
+
+    spiBeginTransaction();
+    digitalWrite(_cs, LOW);
+    for (uint8_t page = 0; page < PAGE_COUNT; page++)
     {
-        setAddrWindow(page, 0);
+        const uint8_t *row = &buffer[page * LCD_WIDTH];
+        uint8_t x0 = 0;
+        uint8_t x1 = LCD_WIDTH - 1;
+        if (diff)
+        {
+            const uint8_t *shadow = &_shadowBuffer[page * LCD_WIDTH];
+            while (x0 < LCD_WIDTH && row[x0] == shadow[x0])
+                x0++;
+            if (x0 == LCD_WIDTH)
+                continue; // 该页没有变化
+            while (row[x1] == shadow[x1])
+                x1--;
+        }
 
-        // 批量填充模式数据
+        const uint8_t addr[3] = {(uint8_t)(0xB0 + page), (uint8_t)(0x10 + (x0 >> 4)), (uint8_t)(x0 & 0x0F)};
+        digitalWrite(_dc, LOW);
+        spiWriteRaw(addr, sizeof(addr));
         digitalWrite(_dc, HIGH);
-        digitalWrite(_cs, LOW);
+        spiWriteRaw(row + x0, x1 - x0 + 1);
+    }
+    digitalWrite(_cs, HIGH);
+    spiEndTransaction();
+
+    if (_shadowBuffer != nullptr)
+    {
+        memcpy(_shadowBuffer, buffer, FRAME_SIZE);
+        _shadowValid = true;
+    }
+}
+
+/**
+ * @brief 查询异步刷新是否仍在进行
+ * @return true:传输进行中
+ */
+bool ST7567_LCD::isFlushBusy()
+{
+    return _flushEngine != nullptr && _flushEngine->isBusy();
+}
+
+/**
+ * @brief 等待异步刷新完成
+ */
+void ST7567_LCD::waitFlush()
+{
+    if (_flushEngine != nullptr)
+    {
+        _flushEngine->wait();
+    }
+}
+
+/**
+ * @brief 设置异步传输引擎
+ * @param engine 传输引擎（nullptr恢复为SPIClass/软件SPI）
+ *
+ * 应在begin()之前调用；begin()之后设置时立即初始化引擎
+ */
+void ST7567_LCD::setFlushEngine(ST7567_FlushEngine *engine)
+{
+    waitFlush();
+    _flushEngine = engine;
+    if (_flushEngine != nullptr)
+    {
+        _flushEngine->setCompletionCallback(_flushCallback, _flushCallbackContext);
+        if (_initialized)
+        {
+            _flushEngine->begin();
+        }
+    }
+}
+
+/**
+ * @brief 设置异步刷新完成回调
+ * @param callback 回调函数（nullptr取消）
+ * @param context 用户上下文
+ */
+void ST7567_LCD::setFlushCallback(ST7567_FlushCallback callback, void *context)
+{
+    _flushCallback = callback;
+    _flushCallbackContext = context;
+    if (_flushEngine != nullptr)
+    {
+        _flushEngine->setCompletionCallback(callback, context);
+    }
+}
+
+/**
+ * @brief 只刷新脏区域（增量刷新）
+ *
+ * 刷新流程：
+ * 1. 遍历8页，跳过没有脏区的页
+ * 2. 每个脏页只设置一次地址窗口，发送[_dirtyX0, _dirtyX1]列区间
+ * 3. 刷新完成后清除脏区记录
+ *
+ * 性能优化：
+ * - 仪表盘类界面每帧只改动约5%的区域，SPI数据量相应减少
+ * - 没有脏区时不产生任何SPI传输
+ */
+void ST7567_LCD::displayDirty()
+{
+    if (!_displayEnabled || _pageMode || !isDirty())
+    {
+        return;
+    }
+
+    uint32_t startTime = micros();
+    beginBatch();
+
+    for (uint8_t page = 0; page < PAGE_COUNT; page++)
+    {
+        if (_dirtyX0[page] > _dirtyX1[page])
+            continue; // 该页未修改
+
+        uint8_t x0 = _dirtyX0[page];
+        uint16_t len = _dirtyX1[page] - x0 + 1;
+        writePage(page, x0, &frameBuffer[page * LCD_WIDTH + x0], len);
+        syncShadow(page, x0, len);
+    }
+
+    endBatch();
+
+    clearDirty();
+    recordFlush(startTime, false);
+    updateFrameStats();
+}
+
+/**
+ * @brief 读取32位字（按字节拷贝，不要求地址对齐）
+ */
+static inline uint32_t load32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief 影子缓冲区差分刷新
+ * @param buffer 待发送的帧数据
+ *
+ * 比较流程：
+ * 1. 每页按32位字比较帧缓冲区与影子缓冲区（每页32次比较）
+ * 2. 不同的字再收缩到字节边界，得到差异区间
+ * 3. 与上一区间的间隙不超过SHADOW_MERGE_GAP时合并，否则先发送上一区间
+ * 4. 发送后将该页拷贝到影子缓冲区
+ *
+ * 与脏区跟踪不同，此方法能发现绕过绘图函数的直接缓冲区修改
+ */
+void ST7567_LCD::displayDiff(const uint8_t *buffer)
+{
+    uint32_t startTime = micros();
+    bool transaction = false;
+
+    for (uint8_t page = 0; page < PAGE_COUNT; page++)
+    {
+        const uint8_t *cur = &buffer[page * LCD_WIDTH];
+        uint8_t *old = &_shadowBuffer[page * LCD_WIDTH];
+        int16_t runStart = -1;
+        int16_t runEnd = -1;
 
-        for (uint16_t i = 0; i < LCD_WIDTH; i++)
+        for (uint8_t col = 0; col < LCD_WIDTH; col += 4)
         {
-            if (_useHardwareSPI && _spi)
+            if (load32(&cur[col]) == load32(&old[col]))
+                continue;
+
+            // 收缩到实际不同的字节
+            int16_t b0 = col;
+            int16_t b1 = col + 3;
+            while (cur[b0] == old[b0])
+                b0++;
+            while (cur[b1] == old[b1])
+                b1--;
+
+            if (runStart < 0)
             {
-                _spi->transfer(pattern);
+                runStart = b0;
             }
-            else
+            else if (b0 - runEnd - 1 > SHADOW_MERGE_GAP)
             {
-                shiftOut(_mosi, _sclk, MSBFIRST, pattern);
+                // 间隙太大，先发送上一区间
+                if (!transaction)
+                {
+                    beginBatch();
+                    transaction = true;
+                }
+                writePage(page, runStart, &cur[runStart], runEnd - runStart + 1);
+                runStart = b0;
             }
+            runEnd = b1;
         }
 
-        digitalWrite(_cs, HIGH);
+        if (runStart < 0)
+            continue; // 该页没有变化
+
+        if (!transaction)
+        {
+            beginBatch();
+            transaction = true;
+        }
+        writePage(page, runStart, &cur[runStart], runEnd - runStart + 1);
+        memcpy(old, cur, LCD_WIDTH);
     }
 
-    spiEndTransaction();
+    if (transaction)
+    {
+        endBatch();
+    }
 
-    // 同时清空帧缓冲区
-    if (frameBuffer)
+    clearDirty();
+    recordFlush(startTime, false);
+    updateFrameStats();
+}
+
+/**
+ * @brief 启用/关闭影子缓冲区差分刷新
+ * @param enable true:启用, false:关闭
+ *
+ * 启用时分配1KB影子缓冲区并标记为无效，下一次display()全屏刷新后开始差分
+ */
+void ST7567_LCD::setShadowBuffer(bool enable)
+{
+    if (enable && _shadowBuffer == nullptr && !_pageMode)
+    {
+        _shadowBuffer = new uint8_t[FRAME_SIZE];
+        _shadowValid = false;
+    }
+    else if (!enable && _shadowBuffer != nullptr)
     {
-        memset(frameBuffer, pattern, FRAME_SIZE);
+        delete[] _shadowBuffer;
+        _shadowBuffer = nullptr;
+        _shadowValid = false;
     }
 }
 
 /**
- * @brief 设置显示反色
- * @param invert 反色标志
+ * @brief 登记脏区域
+ * @param x 起始X坐标
+ * @param y 起始Y坐标
+ * @param w 区域宽度
+ * @param h 区域高度
  *
- * 反色显示效果：
- * - 正常显示：亮像素在暗背景上
- * - 反色显示：暗像素在亮背景上
+ * 用于通过getFrameBuffer()直接写缓冲区的场景，区域会自动裁剪到屏幕范围
  */
-void ST7567_LCD::invertDisplay(bool invert)
+void ST7567_LCD::markDirtyRegion(int16_t x, int16_t y, int16_t w, int16_t h)
 {
-    spiBeginTransaction();
-    writeCommand(invert ? 0xA7 : 0xA6); // 0xA7:反色, 0xA6:正常
-    spiEndTransaction();
+    if (w <= 0 || h <= 0)
+        return;
+
+    int16_t x1 = min((int16_t)(x + w - 1), (int16_t)(LCD_WIDTH - 1));
+    int16_t y1 = min((int16_t)(y + h - 1), (int16_t)(LCD_HEIGHT - 1));
+    if (x < 0)
+        x = 0;
+    if (y < 0)
+        y = 0;
+    if (x > x1 || y > y1)
+        return;
+
+    markDirty(x, x1, y / 8, y1 / 8);
 }
 
 /**
- * @brief 设置对比度
- * @param contrast 对比度值（0x00-0xFF）
+ * @brief 将整个屏幕标记为脏区域
+ */
+void ST7567_LCD::markAllDirty()
+{
+    memset(_dirtyX0, 0, sizeof(_dirtyX0));
+    memset(_dirtyX1, LCD_WIDTH - 1, sizeof(_dirtyX1));
+}
+
+/**
+ * @brief 清除所有脏区记录
  *
- * 对比度调节：
- * - 较低值：显示较淡
- * - 较高值：显示较深
- * - 建议范围：0x10-0x30
+ * 空页用 起始列(0xFF) > 结束列(0) 表示，markDirty()无需额外判断
  */
-void ST7567_LCD::setContrast(uint8_t contrast)
+void ST7567_LCD::clearDirty()
 {
-    _contrast = contrast;
-    spiBeginTransaction();
-    writeCommand(0x81);      // 对比度设置命令
-    writeCommand(_contrast); // 对比度值
-    spiEndTransaction();
+    memset(_dirtyX0, 0xFF, sizeof(_dirtyX0));
+    memset(_dirtyX1, 0x00, sizeof(_dirtyX1));
 }
 
 /**
- * @brief 设置显示使能状态
- * @param enable true:开启显示, false:关闭显示
+ * @brief 查询是否存在待刷新的脏区域
+ * @return true:存在脏区域
+ */
+bool ST7567_LCD::isDirty() const
+{
+    for (uint8_t page = 0; page < PAGE_COUNT; page++)
+    {
+        if (_dirtyX0[page] <= _dirtyX1[page])
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 更新帧率统计
  *
- * 用途：
- * - 节能模式：关闭显示降低功耗
- * - 闪烁效果：快速开关创建闪烁
- * - 数据传输期间避免显示杂讯
+ * 每次完成一帧刷新（全屏或增量）后调用，每秒更新一次_fps
  */
-void ST7567_LCD::setDisplayEnabled(bool enable)
+void ST7567_LCD::updateFrameStats()
 {
-    _displayEnabled = enable;
-    spiBeginTransaction();
-    writeCommand(enable ? 0xAF : 0xAE); // 0xAF:开启, 0xAE:关闭
-    spiEndTransaction();
+    _frameCount++;
+    uint32_t currentTime = millis();
+    if (currentTime - _lastStatTime >= 1000)
+    {
+        _fps = _frameCount;
+        _frameCount = 0;
+        _lastStatTime = currentTime;
+    }
 }
 
 /**
- * @brief 双缓冲切换显示
- * @param newBuffer 新帧缓冲区指针
+ * @brief 根据SPI时钟设置默认代价模型参数
  *
- * 双缓冲优势：
- * - 消除画面撕裂
- * - 提高渲染流畅度
- * - 支持后台渲染
+ * 硬件SPI每字节8个时钟周期；软件SPI无法从频率推算，使用SOFT_SPI_BYTE_NS。
+ * 每段开销 = 地址命令字节 + SEGMENT_OVERHEAD_NS（DC切换和调用开销）
+ */
+void ST7567_LCD::initFlushCost()
+{
+    _byteCostNs = (_spiFrequency > 0) ? (8000000000ULL + _spiFrequency - 1) / _spiFrequency : SOFT_SPI_BYTE_NS;
+    _segmentCostNs = ADDR_CMD_BYTES * _byteCostNs + SEGMENT_OVERHEAD_NS;
+}
+
+/**
+ * @brief 测量刷新代价模型参数
+ * @return true:测量成功, false:计时精度不足，保留原参数
  *
- * 使用流程：
- * 1. 在后台缓冲区渲染内容
- * 2. 调用swapBuffers()切换显示
- * 3. 继续在另一个缓冲区渲染下一帧
+ * 测量流程：
+ * 1. 一次批次内重复CALIBRATE_REPS次发送第0页第0列的1字节段
+ * 2. 再重复发送第0页整页128字节段
+ * 3. 每字节开销 = 两者耗时差 / (次数 × 127)，每段开销 = 短段平均耗时 - 每字节开销
+ *
+ * 两组都发送帧缓冲区中的现有内容，显示不变
+ */
+bool ST7567_LCD::calibrateFlushCost()
+{
+    const uint8_t CALIBRATE_REPS = 16;
+
+    beginBatch();
+    uint32_t t0 = micros();
+    for (uint8_t i = 0; i < CALIBRATE_REPS; i++)
+    {
+        writePage(0, 0, frameBuffer, 1);
+    }
+    uint32_t t1 = micros();
+    for (uint8_t i = 0; i < CALIBRATE_REPS; i++)
+    {
+        writePage(0, 0, frameBuffer, LCD_WIDTH);
+    }
+    uint32_t t2 = micros();
+    endBatch();
+
+    uint32_t shortUs = t1 - t0;
+    uint32_t longUs = t2 - t1;
+    if (longUs <= shortUs)
+    {
+        return false; // micros()分辨率不足以区分两组
+    }
+
+    uint32_t byteNs = (uint32_t)((uint64_t)(longUs - shortUs) * 1000 / ((uint32_t)CALIBRATE_REPS * (LCD_WIDTH - 1)));
+    uint32_t shortNs = (uint32_t)((uint64_t)shortUs * 1000 / CALIBRATE_REPS);
+    if (byteNs == 0)
+    {
+        byteNs = 1;
+    }
+
+    _byteCostNs = byteNs;
+    _segmentCostNs = (shortNs > byteNs) ? shortNs - byteNs : byteNs;
+
+    Serial.printf("ST7567: Flush cost calibrated: %lu ns/segment, %lu ns/byte\n",
+                  (unsigned long)_segmentCostNs, (unsigned long)_byteCostNs);
+    return true;
+}
+
+/**
+ * @brief 手动设置刷新代价模型参数
+ * @param segmentNs 每段固定开销（纳秒）
+ * @param byteNs 每数据字节开销（纳秒，为0时按1处理）
+ */
+void ST7567_LCD::setFlushCost(uint32_t segmentNs, uint32_t byteNs)
+{
+    _segmentCostNs = segmentNs;
+    _byteCostNs = byteNs > 0 ? byteNs : 1;
+    _flushCostFixed = true;
+}
+
+/**
+ * @brief 智能局部刷新函数（代价模型版本）
+ * @param x 起始X坐标（0-127）
+ * @param y 起始Y坐标（0-63）
+ * @param width 刷新区域宽度
+ * @param height 刷新区域高度
+ * @return 实际采用的刷新策略
+ *
+ * 策略选择（代价 = 段数 × 每段开销 + 字节数 × 每字节开销）：
+ * 1. 区域涉及的每一页默认只发送区域列区间（FLUSH_REGION）
+ * 2. 该页已有脏区时比较"一次发送并集"与"本次发区域、之后再单独发脏区"，
+ *    并集更便宜则合并发送并清除该页脏区（FLUSH_MERGED）
+ * 3. 只有当计划代价不低于全屏刷新时才改用display()（FLUSH_FULL）
+ *
+ * 小区域的代价远低于8页整页传输，因此光标闪烁、状态图标等永远不会触发全屏刷新
+ *
+ * 适用场景：
+ * - 游戏精灵动画更新
+ * - 文本光标闪烁
+ * - 进度条局部更新
+ * - 图表数据刷新
+ */
+ST7567_LCD::FlushStrategy ST7567_LCD::refreshRegion(int16_t x, int16_t y, uint16_t width, uint16_t height)
+{
+    // 边界检查和裁剪（页模式下没有整帧内容可发送）
+    if (_pageMode || x >= LCD_WIDTH || y >= LCD_HEIGHT || width == 0 || height == 0 ||
+        x + (int32_t)width <= 0 || y + (int32_t)height <= 0)
+    {
+        _lastStrategy = FLUSH_NONE;
+        return FLUSH_NONE;
+    }
+
+    // 裁剪到有效区域
+    int16_t endX = (int16_t)min((int32_t)x + width - 1, (int32_t)LCD_WIDTH - 1);
+    int16_t endY = (int16_t)min((int32_t)y + height - 1, (int32_t)LCD_HEIGHT - 1);
+    if (x < 0)
+        x = 0;
+    if (y < 0)
+        y = 0;
+
+    // 计算涉及的页范围（每页8行）
+    uint8_t startPage = y / 8;
+    uint8_t endPage = endY / 8;
+
+    // 为每页确定发送区间并累计代价
+    uint8_t spanX0[PAGE_COUNT];
+    uint8_t spanX1[PAGE_COUNT];
+    uint32_t planCost = 0;
+    bool merged = false;
+
+    for (uint8_t page = startPage; page <= endPage; page++)
+    {
+        uint8_t x0 = x;
+        uint8_t x1 = endX;
+
+        if (_dirtyX0[page] <= _dirtyX1[page])
+        {
+            uint8_t u0 = min(x0, _dirtyX0[page]);
+            uint8_t u1 = max(x1, _dirtyX1[page]);
+            uint32_t mergedCost = flushCost(1, u1 - u0 + 1);
+            uint32_t separateCost = flushCost(1, x1 - x0 + 1) + flushCost(1, _dirtyX1[page] - _dirtyX0[page] + 1);
+            if (mergedCost <= separateCost)
+            {
+                if (u0 < x0 || u1 > x1)
+                    merged = true;
+                x0 = u0;
+                x1 = u1;
+            }
+        }
+
+        spanX0[page] = x0;
+        spanX1[page] = x1;
+        planCost += flushCost(1, x1 - x0 + 1);
+    }
+
+    if (planCost >= flushCost(PAGE_COUNT, FRAME_SIZE))
+    {
+        display();
+        _lastStrategy = FLUSH_FULL;
+        return FLUSH_FULL;
+    }
+
+    uint32_t startTime = micros();
+    beginBatch();
+
+    // 逐页发送，地址命令与数据并入同一批次
+    for (uint8_t page = startPage; page <= endPage; page++)
+    {
+        uint8_t x0 = spanX0[page];
+        uint16_t len = spanX1[page] - x0 + 1;
+        writePage(page, x0, &frameBuffer[page * LCD_WIDTH + x0], len);
+        syncShadow(page, x0, len);
+
+        // 该页脏区已被本次刷新完全覆盖时，清除其记录
+        if (_dirtyX0[page] >= x0 && _dirtyX1[page] <= spanX1[page])
+        {
+            _dirtyX0[page] = 0xFF;
+            _dirtyX1[page] = 0x00;
+        }
+    }
+
+    endBatch();
+    recordFlush(startTime, false);
+
+    _lastStrategy = merged ? FLUSH_MERGED : FLUSH_REGION;
+    return _lastStrategy;
+}
+
+/**
+ * @brief 清空帧缓冲区
+ *
+ * 将帧缓冲区所有字节设置为0，即清空屏幕
+ * 注意：此操作只清空缓冲区，需要调用display()才能实际更新显示
+ */
+void ST7567_LCD::clearDisplay()
+{
+    memset(frameBuffer, 0x00, getFrameBufferSize());
+    markAllDirty();
+}
+
+/**
+ * @brief 快速清屏并刷新（优化版本）
+ * @param pattern 填充模式（0x00:全黑, 0xFF:全白, 其他:图案）
+ *
+ * 优化点：
+ * - 直接操作显示内存，跳过帧缓冲区
+ * - 使用图案填充减少数据传输
+ * - 支持快速清屏模式
+ */
+void ST7567_LCD::clearScreen(uint8_t pattern)
+{
+    beginBatch();
+
+    // 直接填充显示内存，避免帧缓冲区操作
+    for (uint8_t page = 0; page < PAGE_COUNT; page++)
+    {
+        const uint8_t addr[3] = {(uint8_t)(0xB0 + page), 0x10, 0x00};
+        batchCommands(addr, sizeof(addr)); // 设置页和列地址
+        batchPattern(pattern, LCD_WIDTH);  // 图案填充整页
+    }
+
+    endBatch();
+
+    // 同时清空帧缓冲区，显示内容与缓冲区已一致
+    memset(frameBuffer, pattern, getFrameBufferSize());
+    if (_shadowBuffer != nullptr)
+    {
+        memset(_shadowBuffer, pattern, FRAME_SIZE);
+        _shadowValid = true;
+    }
+    clearDirty();
+}
+
+/**
+ * @brief 设置显示反色
+ * @param invert 反色标志
+ *
+ * 反色显示效果：
+ * - 正常显示：亮像素在暗背景上
+ * - 反色显示：暗像素在亮背景上
+ */
+void ST7567_LCD::invertDisplay(bool invert)
+{
+    const uint8_t cmd = invert ? 0xA7 : 0xA6; // 0xA7:反色, 0xA6:正常
+    writeCommands(&cmd, 1);
+}
+
+/**
+ * @brief 设置对比度
+ * @param contrast 对比度值（0x00-0xFF）
+ *
+ * 对比度调节：
+ * - 较低值：显示较淡
+ * - 较高值：显示较深
+ * - 建议范围：0x10-0x30
+ */
+void ST7567_LCD::setContrast(uint8_t contrast)
+{
+    _contrast = contrast;
+    const uint8_t cmds[2] = {0x81, _contrast}; // 对比度设置命令 + 对比度值
+    writeCommands(cmds, sizeof(cmds));
+}
+
+/**
+ * @brief 设置显示使能状态
+ * @param enable true:开启显示, false:关闭显示
+ *
+ * 用途：
+ * - 节能模式：关闭显示降低功耗
+ * - 闪烁效果：快速开关创建闪烁
+ * - 数据传输期间避免显示杂讯
+ */
+void ST7567_LCD::setDisplayEnabled(bool enable)
+{
+    _displayEnabled = enable;
+    const uint8_t cmd = enable ? 0xAF : 0xAE; // 0xAF:开启, 0xAE:关闭
+    writeCommands(&cmd, 1);
+}
+
+/**
+ * @brief 双缓冲切换显示
+ * @param newBuffer 新帧缓冲区指针
+ *
+ * 双缓冲优势：
+ * - 消除画面撕裂
+ * - 提高渲染流畅度
+ * - 支持后台渲染
+ *
+ * 使用流程：
+ * 1. 在后台缓冲区渲染内容
+ * 2. 调用swapBuffers()切换显示
+ * 3. 继续在另一个缓冲区渲染下一帧
+ *
+ * @note 如果newBuffer为nullptr，使用常驻双缓冲交换（首次调用时分配一次），
+ * 交换后后台缓冲区按setSwapMode()设置的方式处理；
+ * 非空时驱动接管newBuffer（以new[]分配）并释放原缓冲区
+ */
+void ST7567_LCD::swapBuffers(uint8_t *newBuffer)
+{
+    if (_pageMode)
+        return;
+
+    if (newBuffer == nullptr)
+    {
+        swapBuffers(_swapMode);
+        return;
+    }
+
+    // 切换到新缓冲区（绑定外部缓冲区时释放的是保存的自有缓冲区）
+    waitFlush();
+    if (_ownBuffer != nullptr)
+    {
+        releaseFrameBuffer(_ownBuffer);
+        _ownBuffer = nullptr;
+    }
+    else
+    {
+        releaseFrameBuffer(frameBuffer);
+    }
+    frameBuffer = newBuffer;
+
+    // 立即刷新显示
+    display();
+}
+
+/**
+ * @brief 常驻双缓冲交换（无堆操作）
+ * @param mode 交换后后台缓冲区的处理方式
+ *
+ * 交换流程：
+ * 1. 等待前台缓冲区的异步传输完成（它即将成为绘制目标）
+ * 2. 交换frameBuffer与_frontBuffer指针（O(1)）
+ * 3. 发送新的前台缓冲区：有传输引擎时直接异步提交，无需快照拷贝
+ * 4. 按mode处理新的后台缓冲区
+ */
+void ST7567_LCD::swapBuffers(SwapMode mode)
+{
+    if (_pageMode)
+        return;
+
+    if (_frontBuffer == nullptr)
+    {
+        setDoubleBuffer(true);
+        if (_frontBuffer == nullptr)
+            return; // 绑定了外部缓冲区
+    }
+
+    waitFlush();
+
+    uint8_t *drawn = frameBuffer;
+    frameBuffer = _frontBuffer;
+    _frontBuffer = drawn;
+
+    if (_displayEnabled)
+    {
+        if (_flushEngine == nullptr || !submitFrame(_frontBuffer))
+        {
+            flushFrame(_frontBuffer);
+        }
+    }
+
+    switch (mode)
+    {
+    case SWAP_COPY: // 在刚显示的内容上继续增量绘制
+        memcpy(frameBuffer, _frontBuffer, FRAME_SIZE);
+        break;
+    case SWAP_CLEAR: // 每帧重绘
+        memset(frameBuffer, 0x00, FRAME_SIZE);
+        markAllDirty();
+        break;
+    case SWAP_KEEP: // 保留两帧前的内容，调用者自行覆盖
+    default:
+        markAllDirty();
+        break;
+    }
+}
+
+/**
+ * @brief 启用/关闭常驻双缓冲
+ * @param enable true:分配前台缓冲区, false:释放
+ *
+ * 启用时前台缓冲区复制当前帧缓冲区内容
+ */
+void ST7567_LCD::setDoubleBuffer(bool enable)
+{
+    waitFlush();
+    if (enable && _frontBuffer == nullptr && !_pageMode && _ownBuffer == nullptr)
+    {
+        _frontBuffer = new uint8_t[FRAME_SIZE];
+        memcpy(_frontBuffer, frameBuffer, FRAME_SIZE);
+    }
+    else if (!enable && _frontBuffer != nullptr)
+    {
+        // 交换后静态缓冲区可能在前台：内容移回静态缓冲区，释放堆上的一个
+        if (_frontBuffer == _staticBuffer)
+        {
+            memcpy(_staticBuffer, frameBuffer, FRAME_SIZE);
+            _frontBuffer = frameBuffer;
+            frameBuffer = _staticBuffer;
+        }
+        delete[] _frontBuffer;
+        _frontBuffer = nullptr;
+    }
+}
+
+/**
+ * @brief 以外部缓冲区作为绘制目标
+ * @param buffer 外部帧缓冲区，nullptr恢复自有缓冲区
+ *
+ * 只交换指针，不接管所有权：
+ * - 首次绑定时保存自有缓冲区，重复绑定只替换外部指针
+ * - 恢复时当前内容复制回自有缓冲区，绘制状态保持连续
+ * 异步快照和双缓冲发送的都不是frameBuffer，因此无需等待传输完成
+ */
+void ST7567_LCD::attachFrameBuffer(uint8_t *buffer)
+{
+    if (_pageMode || _frontBuffer != nullptr)
+        return;
+
+    if (buffer == nullptr)
+    {
+        if (_ownBuffer == nullptr)
+            return;
+        if (frameBuffer != _ownBuffer)
+            memcpy(_ownBuffer, frameBuffer, FRAME_SIZE);
+        frameBuffer = _ownBuffer;
+        _ownBuffer = nullptr;
+    }
+    else
+    {
+        if (_ownBuffer == nullptr)
+            _ownBuffer = frameBuffer;
+        frameBuffer = buffer;
+    }
+    markAllDirty();
+}
+
+/**
+ * @brief 启用/关闭页模式
+ * @param enable true:释放1KB帧缓冲区改用128字节页缓冲区, false:恢复整帧缓冲区
+ *
+ * 启用时同时释放双缓冲、影子缓冲区和异步快照（它们都是整帧大小），
+ * 之后只能通过renderPaged()绘制和刷新。建议在begin()之前调用
+ */
+void ST7567_LCD::setPageMode(bool enable)
+{
+    if (enable == _pageMode || _ownBuffer != nullptr)
+        return;
+
+    waitFlush();
+
+    if (enable)
+    {
+        setDoubleBuffer(false);
+        setShadowBuffer(false);
+        if (_asyncBuffer != nullptr)
+        {
+            delete[] _asyncBuffer;
+            _asyncBuffer = nullptr;
+        }
+        releaseFrameBuffer(frameBuffer);
+
+        _pageBuffers[0] = new uint8_t[LCD_WIDTH]();
+        frameBuffer = _pageBuffers[0];
+        _pageMode = true;
+        _bufferPage = 0;
+        _clipY0 = 0;
+        _clipY1 = 7;
+    }
+    else
+    {
+        for (uint8_t i = 0; i < 2; i++)
+        {
+            if (_pageBuffers[i] != nullptr)
+            {
+                delete[] _pageBuffers[i];
+                _pageBuffers[i] = nullptr;
+            }
+        }
+
+        if (_staticBuffer != nullptr)
+        {
+            memset(_staticBuffer, 0x00, FRAME_SIZE);
+            frameBuffer = _staticBuffer;
+        }
+        else
+        {
+            frameBuffer = new uint8_t[FRAME_SIZE]();
+        }
+        _pageMode = false;
+        _bufferPage = 0;
+        _clipY0 = 0;
+        _clipY1 = LCD_HEIGHT - 1;
+        markAllDirty();
+    }
+}
+
+/**
+ * @brief 页模式渲染一帧
+ * @param draw 绘制回调（每页调用一次，共8次）
+ * @param context 传给回调的用户上下文
+ *
+ * 渲染流程（每页）：
+ * 1. 页缓冲区清零，裁剪窗口设为该页的8行
+ * 2. 调用绘制回调，回调绘制整帧内容，绘图函数只写入落在当前页的部分
+ * 3. 立即发送该页（3字节地址命令 + 128字节数据）
+ *
+ * 设置了传输引擎时使用两个页缓冲区交替：第N页在后台发送时渲染第N+1页，
+ * 引擎提交前会等待上一页完成，因此被复用的缓冲区已发送完毕
+ *
+ * @note 回调会被调用8次，必须每次绘制相同的内容（不能在回调中推进动画状态）
+ */
+void ST7567_LCD::renderPaged(PageRenderCallback draw, void *context)
+{
+    if (!_pageMode || draw == nullptr || !_displayEnabled)
+        return;
+
+    uint32_t startTime = micros();
+    bool overlap = (_flushEngine != nullptr);
+    if (overlap && _pageBuffers[1] == nullptr)
+    {
+        _pageBuffers[1] = new uint8_t[LCD_WIDTH];
+    }
+
+    for (uint8_t page = 0; page < PAGE_COUNT; page++)
+    {
+        frameBuffer = _pageBuffers[overlap ? (page & 1) : 0];
+        _bufferPage = page;
+        _clipY0 = page * 8;
+        _clipY1 = _clipY0 + 7;
+        memset(frameBuffer, 0x00, LCD_WIDTH);
+
+        draw(*this, _clipY0, _clipY1, context);
+
+        bool submitted = false;
+        if (overlap)
+        {
+            _asyncCmds[page][0] = 0xB0 + page; // 页地址
+            _asyncCmds[page][1] = 0x10;        // 列地址高4位
+            _asyncCmds[page][2] = 0x00;        // 列地址低4位
+
+            ST7567_FlushSegment segments[2] = {
+                {_asyncCmds[page], ADDR_CMD_BYTES, false},
+                {frameBuffer, LCD_WIDTH, true}};
+            submitted = _flushEngine->submit(segments, 2);
+            if (submitted)
+            {
+                ST7567_METRIC(_metrics.bytesSent += ADDR_CMD_BYTES + LCD_WIDTH);
+                ST7567_METRIC(_metrics.commandBytes += ADDR_CMD_BYTES);
+                ST7567_METRIC(_metrics.csToggles += 2);
+                ST7567_METRIC(_metrics.dcToggles += 2);
+            }
+        }
+        if (!submitted)
+        {
+            beginBatch();
+            writePage(page, 0, frameBuffer, LCD_WIDTH);
+            endBatch();
+        }
+    }
+
+    // 恢复到第0页，页模式外的绘图调用不会越界
+    frameBuffer = _pageBuffers[0];
+    _bufferPage = 0;
+    _clipY0 = 0;
+    _clipY1 = 7;
+
+    clearDirty();
+    recordFlush(startTime, true);
+    updateFrameStats();
+}
+
+/**
+ * @brief 绘制像素点（重写Adafruit_GFX虚函数）
+ * @param x 像素点X坐标
+ * @param y 像素点Y坐标
+ * @param color 颜色（ST7567_BLACK:清除, ST7567_WHITE:设置, ST7567_INVERSE:反转）
+ *
+ * 像素存储格式：
+ * - 垂直8像素为一页，MSB在顶部
+ * - 帧缓冲区索引：page * 128 + column
+ * - 位位置：y % 8
+ *
+ * 优化点：
+ * - 快速边界检查
+ * - 使用位运算提高效率
+ * - 支持多种颜色模式
+ * - 支持setRotation()（坐标映射到物理坐标后写入）
+ */
+void ST7567_LCD::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_PIXEL]++);
+
+    // 旋转映射到物理坐标（每个像素一次switch，旋转0时只有一次比较）
+    if (rotation != 0)
+        rotatePoint(rotation, x, y);
+
+    // 边界检查（使用快速比较，页模式下行范围为当前页）
+    if ((x < 0) || (x >= LCD_WIDTH) || (y < _clipY0) || (y > _clipY1))
+        return;
+
+    // 计算帧缓冲区中的位置
+    uint8_t page = y / 8;       // 页号
+    uint8_t bit = 1 << (y % 8); // 位掩码
+
+    markDirty(x, x, page, page);
+
+    // 设置、清除或反转指定位
+    st7567_applyMaskByte(pageRow(page)[x], bit, color);
+}
+
+/**
+ * @brief 批量写入缓冲区数据到显示屏
+ * @param buffer 数据缓冲区指针
+ * @param length 数据长度
+ *
+ * 适用于：
+ * - 预先渲染好的图像数据
+ * - 从外部存储器加载的图形
+ * - 需要绕过帧缓冲区的特殊应用
+ *
+ * 性能优化：
+ * - 直接DMA传输（如果支持）
+ * - 减少内存拷贝操作
+ * - 支持大容量数据传输
+ */
+void ST7567_LCD::writeBuffer(const uint8_t *buffer, size_t length)
+{
+    if (length > FRAME_SIZE)
+        length = FRAME_SIZE;
+
+    beginBatch();
+    writePage(0, 0, buffer, length); // 从显示起始位置直接写入数据
+    endBatch();
+
+    // 显示RAM已被绕过帧缓冲区修改，影子缓冲区不再可信
+    _shadowValid = false;
+}
+
+/**
+ * @brief 绘制水平线（优化版本）
+ * @param x 起始X坐标
+ * @param y 起始Y坐标
+ * @param w 线宽度
+ * @param color 颜色
+ *
+ * 优化策略：
+ * - 使用字节操作代替逐像素绘制
+ * - 减少边界检查次数
+ * - 支持快速填充模式
+ * - 旋转在函数入口映射一次，之后与旋转0走相同的内核
+ */
+void ST7567_LCD::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_HLINE]++);
+
+    rotatedSpanH(x, y, w, color);
+}
+
+/**
+ * @brief 按当前旋转写入逻辑水平跨度
+ * @param x 起始X坐标
+ * @param y Y坐标
+ * @param w 宽度
+ * @param color 颜色
+ *
+ * 旋转1/3时逻辑水平线是物理竖直线，走页式竖直内核
+ */
+void ST7567_LCD::rotatedSpanH(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    if (w <= 0)
+        return;
+
+    switch (rotation)
+    {
+    case 1:
+        writeSpanV(LCD_WIDTH - 1 - y, x, x + w - 1, color);
+        break;
+    case 2:
+        writeSpanH(LCD_WIDTH - x - w, LCD_WIDTH - 1 - x, LCD_HEIGHT - 1 - y, color);
+        break;
+    case 3:
+        writeSpanV(y, LCD_HEIGHT - x - w, LCD_HEIGHT - 1 - x, color);
+        break;
+    default:
+        writeSpanH(x, x + w - 1, y, color);
+        break;
+    }
+}
+
+/**
+ * @brief 写入水平跨度
+ * @param x0 起始列
+ * @param x1 结束列（包含）
+ * @param y 行
+ * @param color 颜色
+ */
+void ST7567_LCD::writeSpanH(int16_t x0, int16_t x1, int16_t y, uint16_t color)
+{
+    // 边界检查和裁剪
+    if (y < _clipY0 || y > _clipY1 || x1 < x0)
+        return;
+    if (x0 < 0)
+        x0 = 0;
+    if (x1 >= LCD_WIDTH)
+        x1 = LCD_WIDTH - 1;
+    if (x1 < x0)
+        return;
+
+    // 计算所在页和位掩码
+    uint8_t page = y / 8;
+    uint8_t bit = 1 << (y % 8);
+    markDirty(x0, x1, page, page);
+
+    // 同一页内的连续列：按32位字批量处理
+    st7567_applyMaskSpan(&pageRow(page)[x0], x1 - x0 + 1, bit, color);
+}
+
+/**
+ * @brief 绘制垂直线（优化版本）
+ * @param x 起始X坐标
+ * @param y 起始Y坐标
+ * @param h 线高度
+ * @param color 颜色
+ *
+ * 优化策略：
+ * - 跨页处理优化
+ * - 减少页切换次数
+ * - 支持快速垂直填充
+ */
+void ST7567_LCD::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_VLINE]++);
+
+    rotatedSpanV(x, y, h, color);
+}
+
+/**
+ * @brief 按当前旋转写入逻辑竖直跨度
+ * @param x X坐标
+ * @param y 起始Y坐标
+ * @param h 高度
+ * @param color 颜色
+ *
+ * 旋转1/3时逻辑竖直线是物理水平线，走同页32位字内核
+ */
+void ST7567_LCD::rotatedSpanV(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    if (h <= 0)
+        return;
+
+    switch (rotation)
+    {
+    case 1:
+        writeSpanH(LCD_WIDTH - y - h, LCD_WIDTH - 1 - y, x, color);
+        break;
+    case 2:
+        writeSpanV(LCD_WIDTH - 1 - x, LCD_HEIGHT - y - h, LCD_HEIGHT - 1 - y, color);
+        break;
+    case 3:
+        writeSpanH(y, y + h - 1, LCD_HEIGHT - 1 - x, color);
+        break;
+    default:
+        writeSpanV(x, y, y + h - 1, color);
+        break;
+    }
+}
+
+/**
+ * @brief 写入竖直跨度
+ * @param x 列
+ * @param y0 起始行
+ * @param y1 结束行（包含）
+ * @param color 颜色
+ */
+void ST7567_LCD::writeSpanV(int16_t x, int16_t y0, int16_t y1, uint16_t color)
+{
+    // 边界检查和裁剪
+    if (x < 0 || x >= LCD_WIDTH || y1 < y0)
+        return;
+    if (y0 < _clipY0)
+        y0 = _clipY0;
+    if (y1 > _clipY1)
+        y1 = _clipY1;
+    if (y1 < y0)
+        return;
+
+    // 计算起始页、结束页及首末页的位掩码
+    uint8_t startPage = y0 / 8;
+    uint8_t endPage = y1 / 8;
+    uint8_t firstMask = 0xFF << (y0 & 7);
+    uint8_t lastMask = 0xFF >> (7 - (y1 & 7));
+    markDirty(x, x, startPage, endPage);
+
+    uint8_t *column = &pageRow(startPage)[x];
+
+    // 单页处理：首末掩码取交集
+    if (startPage == endPage)
+    {
+        st7567_applyMaskByte(*column, firstMask & lastMask, color);
+        return;
+    }
+
+    // 跨页处理：首页、中间完整页、末页
+    st7567_applyMaskByte(*column, firstMask, color);
+    for (uint8_t page = startPage + 1; page < endPage; page++)
+    {
+        column += LCD_WIDTH;
+        st7567_applyMaskByte(*column, 0xFF, color);
+    }
+    st7567_applyMaskByte(column[LCD_WIDTH], lastMask, color);
+}
+
+/**
+ * @brief 填充矩形（优化版本）
+ * @param x 矩形左上角X坐标
+ * @param y 矩形左上角Y坐标
+ * @param w 矩形宽度
+ * @param h 矩形高度
+ * @param color 填充颜色
+ *
+ * 页式填充内核：
+ * - 首末页的部分掩码只计算一次，每个字节只访问一次（原先每行一次，共8次）
+ * - 中间完整页用memset（设置/清除）或32位字异或（反转）
+ * - 部分页按32位字应用掩码，非对齐的首尾字节单独处理
+ * - 支持ST7567_BLACK/ST7567_WHITE/ST7567_INVERSE三种颜色
+ * - 旋转时矩形整体映射为物理矩形，仍为一次页式填充
+ */
+void ST7567_LCD::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_FILL_RECT]++);
+
+    if (rotation != 0)
+        rotateRect(rotation, x, y, w, h);
+    writeRect(x, y, w, h, color);
+}
+
+/**
+ * @brief 写入矩形
+ * @param x 矩形左上角X坐标
+ * @param y 矩形左上角Y坐标
+ * @param w 矩形宽度
+ * @param h 矩形高度
+ * @param color 填充颜色
+ */
+void ST7567_LCD::writeRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    // 边界检查和裁剪
+    if (w <= 0 || h <= 0)
+        return;
+    if (x < 0)
+    {
+        w += x;
+        x = 0;
+    }
+    if (y < _clipY0)
+    {
+        h -= _clipY0 - y;
+        y = _clipY0;
+    }
+    if (x + w > LCD_WIDTH)
+    {
+        w = LCD_WIDTH - x;
+    }
+    if (y + h - 1 > _clipY1)
+    {
+        h = _clipY1 - y + 1;
+    }
+    if (w <= 0 || h <= 0)
+        return;
+
+    // 页范围和首末页的部分掩码（只计算一次）
+    uint8_t startPage = y / 8;
+    uint8_t endPage = (y + h - 1) / 8;
+    uint8_t firstMask = 0xFF << (y & 7);
+    uint8_t lastMask = 0xFF >> (7 - ((y + h - 1) & 7));
+    markDirty(x, x + w - 1, startPage, endPage);
+
+    st7567_fillPages(&pageRow(startPage)[x], LCD_WIDTH, w, endPage - startPage + 1, firstMask, lastMask, color);
+}
+
+/**
+ * @brief 绘制直线
+ * @param x0 起点X坐标
+ * @param y0 起点Y坐标
+ * @param x1 终点X坐标
+ * @param y1 终点Y坐标
+ * @param color 颜色
+ *
+ * 与Adafruit_GFX::writeLine()相同的Bresenham步进，但不逐点调用drawPixel()：
+ * - 陡峭的线：同一列上连续的点合成一段竖直跨度，页内部分一次掩码写入
+ * - 平缓的线：同一行上连续的点合成一段水平跨度
+ * - 水平/竖直线直接走跨度路径
+ */
+void ST7567_LCD::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_LINE]++);
+
+    // 在逻辑坐标中步进（与Adafruit_GFX的取舍一致），每段游程按旋转映射一次
+    if (x0 == x1)
+    {
+        rotatedSpanV(x0, min(y0, y1), abs(y1 - y0) + 1, color);
+        return;
+    }
+    if (y0 == y1)
+    {
+        rotatedSpanH(min(x0, x1), y0, abs(x1 - x0) + 1, color);
+        return;
+    }
+
+    // 整条线在屏幕（旋转0时为裁剪窗口）同一侧时直接跳过
+    int16_t top = (rotation == 0) ? _clipY0 : 0;
+    int16_t bottom = (rotation == 0) ? _clipY1 : height() - 1;
+    if ((x0 < 0 && x1 < 0) || (x0 >= width() && x1 >= width()) ||
+        (y0 < top && y1 < top) || (y0 > bottom && y1 > bottom))
+        return;
+
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep)
+    {
+        _swap_int16_t(x0, y0);
+        _swap_int16_t(x1, y1);
+    }
+    if (x0 > x1)
+    {
+        _swap_int16_t(x0, x1);
+        _swap_int16_t(y0, y1);
+    }
+
+    int16_t dx = x1 - x0;
+    int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+
+    // 沿主轴步进，副轴坐标不变的点属于同一游程
+    int16_t runStart = x0;
+    for (; x0 <= x1; x0++)
+    {
+        err -= dy;
+        if (err < 0 || x0 == x1)
+        {
+            if (steep)
+                rotatedSpanV(y0, runStart, x0 - runStart + 1, color);
+            else
+                rotatedSpanH(runStart, y0, x0 - runStart + 1, color);
+
+            y0 += ystep;
+            err += dx;
+            runStart = x0 + 1;
+        }
+    }
+}
+
+/**
+ * @brief 绘制圆
+ * @param x0 圆心X坐标
+ * @param y0 圆心Y坐标
+ * @param r 半径
+ * @param color 颜色
+ */
+void ST7567_LCD::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_SHAPE]++);
+
+    if (rotation != 0)
+        rotatePoint(rotation, x0, y0);
+    circleSpans(x0, y0, r, 3, 0, false, color);
+}
+
+/**
+ * @brief 填充圆
+ * @param x0 圆心X坐标
+ * @param y0 圆心Y坐标
+ * @param r 半径
+ * @param color 颜色
+ */
+void ST7567_LCD::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_SHAPE]++);
+
+    if (rotation != 0)
+        rotatePoint(rotation, x0, y0);
+    circleSpans(x0, y0, r, 3, 0, true, color);
+}
+
+/**
+ * @brief 填充圆角矩形
+ * @param x 左上角X坐标
+ * @param y 左上角Y坐标
+ * @param w 宽度
+ * @param h 高度
+ * @param r 圆角半径
+ * @param color 颜色
+ *
+ * 与Adafruit_GFX::fillRoundRect()的像素集合相同：中间部分走矩形内核，
+ * 两侧圆角按列生成跨度；两部分不重叠，反转颜色时每个像素只翻转一次
+ */
+void ST7567_LCD::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color)
+{
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_SHAPE]++);
+
+    // 圆角矩形旋转后仍是同半径的圆角矩形（宽高互换）
+    if (rotation != 0)
+        rotateRect(rotation, x, y, w, h);
+
+    int16_t maxRadius = ((w < h) ? w : h) / 2;
+    if (r > maxRadius)
+        r = maxRadius;
+    if (r < 0)
+        r = 0;
+
+    writeRect(x + r, y, w - 2 * r, h, color);
+    circleSpans(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, true, color);
+    circleSpans(x + r, y + r, r, 2, h - 2 * r - 1, true, color);
+}
+
+/**
+ * @brief 按列生成圆/圆角的跨度
+ * @param x0 圆心X坐标
+ * @param y0 圆心Y坐标
+ * @param r 半径
+ * @param corners 1:右半边, 2:左半边, 3:整圆
+ * @param delta 填充时下半部分额外延伸的行数
+ * @param fill true:填充, false:只画轮廓
+ * @param color 颜色
+ *
+ * 中点圆算法只计算1/8圆弧上的点(x, y)（x从0递增，y从r递减），其余部分由对称得到：
+ * - 平缓段：列x上只有一个点，到圆心的行距离为y
+ * - 陡峭段：列y上是一段连续的点，行距离为这些点的x
+ * 两段在对角线附近的至多两列（[yn, xn]，(xn, yn)为最后一个点）重合，先累计再输出。
+ * 每列只输出上下两段（填充时一段）竖直跨度，同一页内的像素只做一次掩码写入，
+ * 且每个像素只写一次，反转颜色的结果与置位/清除一致
+ */
+void ST7567_LCD::circleSpans(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, bool fill,
+                             uint16_t color)
+{
+    if (r < 0)
+        return;
+
+    // 整个圆在裁剪窗口之外时直接跳过
+    if (x0 + r < 0 || x0 - r >= LCD_WIDTH || y0 + r + delta < _clipY0 || y0 - r > _clipY1)
+        return;
+
+    // 第一遍：求最后一个点，确定两段重合的列
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    while (x < y)
+    {
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+    }
+    int16_t xn = x;
+    int16_t yn = y;
+
+    // 重合列（至多两列）的行距离范围
+    int16_t midLo[2] = {r, r};
+    int16_t midHi[2] = {-1, -1};
+
+    // 第二遍：逐点归并
+    f = 1 - r;
+    ddF_x = 1;
+    ddF_y = -2 * r;
+    x = 0;
+    y = r;
+    int16_t runCol = -1; // 陡峭段当前游程所在列
+    int16_t runLo = 0;
+    int16_t runHi = 0;
+    for (;;)
+    {
+        // 平缓段：列x，行距离y
+        if (x < yn)
+        {
+            circleColumn(x0, y0, x, y, y, corners, delta, fill, color);
+        }
+        else
+        {
+            midLo[x - yn] = min(midLo[x - yn], y);
+            midHi[x - yn] = max(midHi[x - yn], y);
+        }
+
+        // 陡峭段：列y，行距离x
+        if (y > xn)
+        {
+            if (y != runCol)
+            {
+                if (runCol >= 0)
+                    circleColumn(x0, y0, runCol, runLo, runHi, corners, delta, fill, color);
+                runCol = y;
+                runLo = x;
+            }
+            runHi = x;
+        }
+        else
+        {
+            midLo[y - yn] = min(midLo[y - yn], x);
+            midHi[y - yn] = max(midHi[y - yn], x);
+        }
+
+        if (x >= y)
+            break;
+
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+    }
+
+    if (runCol >= 0)
+        circleColumn(x0, y0, runCol, runLo, runHi, corners, delta, fill, color);
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        if (midHi[i] >= 0)
+            circleColumn(x0, y0, yn + i, midLo[i], midHi[i], corners, delta, fill, color);
+    }
+}
+
+/**
+ * @brief 写入圆的一列
+ * @param x0 圆心X坐标
+ * @param y0 圆心Y坐标
+ * @param c 到圆心的列距离
+ * @param lo 轮廓到圆心的最小行距离
+ * @param hi 轮廓到圆心的最大行距离
+ * @param corners 1:右半边, 2:左半边, 3:整圆
+ * @param delta 填充时下半部分额外延伸的行数
+ * @param fill true:填充, false:只画轮廓
+ * @param color 颜色
+ */
+void ST7567_LCD::circleColumn(int16_t x0, int16_t y0, int16_t c, int16_t lo, int16_t hi,
+                              uint8_t corners, int16_t delta, bool fill, uint16_t color)
+{
+    // 圆心所在列只属于整圆（圆角矩形的这一列由中间矩形覆盖）
+    if (c == 0 && corners != 3)
+        return;
+
+    for (uint8_t side = 1; side <= 2; side++)
+    {
+        if (!(corners & side))
+            continue;
+
+        int16_t x = (side == 1) ? x0 + c : x0 - c;
+        if (fill)
+        {
+            writeSpanV(x, y0 - hi, y0 + hi + delta, color);
+        }
+        else if (lo == 0)
+        {
+            writeSpanV(x, y0 - hi, y0 + hi, color);
+        }
+        else
+        {
+            writeSpanV(x, y0 - hi, y0 - lo, color);
+            writeSpanV(x, y0 + lo, y0 + hi, color);
+        }
+
+        if (c == 0)
+            break;
+    }
+}
+
+/**
+ * @brief 填充三角形
+ * @param x0 顶点0 X坐标
+ * @param y0 顶点0 Y坐标
+ * @param x1 顶点1 X坐标
+ * @param y1 顶点1 Y坐标
+ * @param x2 顶点2 X坐标
+ * @param y2 顶点2 Y坐标
+ * @param color 颜色
+ *
+ * 扫描线与Adafruit_GFX::fillTriangle()相同（像素集合一致，与drawTriangle()的边重合），
+ * 但同一页的8条扫描线先合并为一行列掩码，整页只写一次：每个字节只读改写一次，
+ * 每页只登记一次脏区（旋转1/3时扫描线本身就是页式竖直跨度）
+ */
+void ST7567_LCD::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                              uint16_t color)
+{
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_SHAPE]++);
+
+    // 顶点按Y排序（y0 <= y1 <= y2）
+    if (y0 > y1)
+    {
+        _swap_int16_t(y0, y1);
+        _swap_int16_t(x0, x1);
+    }
+    if (y1 > y2)
+    {
+        _swap_int16_t(y2, y1);
+        _swap_int16_t(x2, x1);
+    }
+    if (y0 > y1)
+    {
+        _swap_int16_t(y0, y1);
+        _swap_int16_t(x0, x1);
+    }
+
+    if (rotation == 0 ? (y2 < _clipY0 || y0 > _clipY1) : (y2 < 0 || y0 >= height()))
+        return;
+
+    // 三点在同一行
+    if (y0 == y2)
+    {
+        int16_t a = min(x0, min(x1, x2));
+        rotatedSpanH(a, y0, max(x0, max(x1, x2)) - a + 1, color);
+        return;
+    }
+
+    SpanBand band;
+    memset(band.mask, 0, sizeof(band.mask));
+    band.page = -1;
+
+    int16_t dx01 = x1 - x0;
+    int16_t dy01 = y1 - y0;
+    int16_t dx02 = x2 - x0;
+    int16_t dy02 = y2 - y0;
+    int16_t dx12 = x2 - x1;
+    int16_t dy12 = y2 - y1;
+    int32_t sa = 0;
+    int32_t sb = 0;
+
+    // 上半部分：边0-1与边0-2之间；y1 == y2时包含y1行，否则y1行留给下半部分
+    int16_t last = (y1 == y2) ? y1 : y1 - 1;
+    int16_t y = y0;
+    for (; y <= last; y++)
+    {
+        int16_t a = x0 + sa / dy01;
+        int16_t b = x0 + sb / dy02;
+        sa += dx01;
+        sb += dx02;
+        triangleRow(band, min(a, b), max(a, b), y, color);
+    }
+
+    // 下半部分：边1-2与边0-2之间
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= y2; y++)
+    {
+        int16_t a = x1 + sa / dy12;
+        int16_t b = x0 + sb / dy02;
+        sa += dx12;
+        sb += dx02;
+        triangleRow(band, min(a, b), max(a, b), y, color);
+    }
+
+    bandFlush(band, color);
+}
+
+/**
+ * @brief 写入三角形的一条扫描线（逻辑坐标）
+ * @param band 页掩码
+ * @param a 起始列
+ * @param b 结束列（包含）
+ * @param y 行
+ * @param color 颜色
+ *
+ * 扫描在逻辑坐标中进行，像素集合与旋转无关地和Adafruit_GFX一致：
+ * 旋转0/2时扫描线是物理行，并入页掩码；旋转1/3时是物理列，直接按页式竖直跨度写入
+ */
+void ST7567_LCD::triangleRow(SpanBand &band, int16_t a, int16_t b, int16_t y, uint16_t color)
+{
+    switch (rotation)
+    {
+    case 1:
+        writeSpanV(LCD_WIDTH - 1 - y, a, b, color);
+        break;
+    case 2:
+        bandSpan(band, LCD_WIDTH - 1 - b, LCD_WIDTH - 1 - a, LCD_HEIGHT - 1 - y, color);
+        break;
+    case 3:
+        writeSpanV(y, LCD_HEIGHT - 1 - b, LCD_HEIGHT - 1 - a, color);
+        break;
+    default:
+        bandSpan(band, a, b, y, color);
+        break;
+    }
+}
+
+/**
+ * @brief 把一条水平跨度并入当前页的列掩码
+ * @param band 页掩码
+ * @param x0 起始列
+ * @param x1 结束列（包含）
+ * @param y 行
+ * @param color 颜色
+ *
+ * 行进入新的页时先写入上一页
+ */
+void ST7567_LCD::bandSpan(SpanBand &band, int16_t x0, int16_t x1, int16_t y, uint16_t color)
+{
+    if (y < _clipY0 || y > _clipY1)
+        return;
+    if (x0 < 0)
+        x0 = 0;
+    if (x1 >= LCD_WIDTH)
+        x1 = LCD_WIDTH - 1;
+    if (x1 < x0)
+        return;
+
+    int16_t page = y / 8;
+    if (page != band.page)
+    {
+        bandFlush(band, color);
+        band.page = page;
+        band.x0 = x0;
+        band.x1 = x1;
+    }
+    else
+    {
+        if (x0 < band.x0)
+            band.x0 = x0;
+        if (x1 > band.x1)
+            band.x1 = x1;
+    }
+
+    st7567_applyMaskSpan(&band.mask[x0], x1 - x0 + 1, 1 << (y & 7), ST7567_WHITE);
+}
+
+/**
+ * @brief 把页掩码写入帧缓冲区并清空
+ * @param band 页掩码
+ * @param color 颜色
+ */
+void ST7567_LCD::bandFlush(SpanBand &band, uint16_t color)
+{
+    if (band.page < 0)
+        return;
+
+    markDirty(band.x0, band.x1, band.page, band.page);
+
+    uint8_t *row = pageRow(band.page);
+    for (int16_t x = band.x0; x <= band.x1; x++)
+    {
+        st7567_applyMaskByte(row[x], band.mask[x], color);
+        band.mask[x] = 0;
+    }
+    band.page = -1;
+}
+
+/**
+ * @brief 绘制字符
+ * @param x 字符左上角X坐标
+ * @param y 字符左上角Y坐标
+ * @param c 字符
+ * @param color 前景颜色
+ * @param bg 背景颜色
+ * @param size 放大倍数
+ */
+void ST7567_LCD::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size)
+{
+    drawChar(x, y, c, color, bg, size, size);
+}
+
+/**
+ * @brief 绘制字符（可分别指定X/Y放大倍数）
+ * @param x 字符左上角X坐标
+ * @param y 字符左上角Y坐标
+ * @param c 字符
+ * @param color 前景颜色
+ * @param bg 背景颜色
+ * @param size_x X方向放大倍数
+ * @param size_y Y方向放大倍数
  *
- * @note 如果newBuffer为nullptr，则创建新的缓冲区并交换
+ * 只有内置字体、1倍大小、无旋转时走快速路径，其余情况保持Adafruit_GFX的行为
  */
-void ST7567_LCD::swapBuffers(uint8_t *newBuffer)
+void ST7567_LCD::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                          uint8_t size_x, uint8_t size_y)
 {
-    if (newBuffer != nullptr)
-    {
-        // 切换到新缓冲区
-        delete[] frameBuffer;
-        frameBuffer = newBuffer;
-    }
-    else
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_CHAR]++);
+
+    if (gfxFont != nullptr || size_x != 1 || size_y != 1 || rotation != 0)
     {
-        // 创建新的后台缓冲区
-        uint8_t *newFrameBuffer = new uint8_t[FRAME_SIZE]();
-        memcpy(newFrameBuffer, frameBuffer, FRAME_SIZE);
-        delete[] frameBuffer;
-        frameBuffer = newFrameBuffer;
+        Adafruit_GFX::drawChar(x, y, c, color, bg, size_x, size_y);
+        return;
     }
 
-    // 立即刷新显示
-    display();
+    // 与Adafruit_GFX相同的裁剪和cp437修正
+    if ((x >= _width) || (y >= _height) || ((x + 6 - 1) < 0) || ((y + 8 - 1) < 0))
+        return;
+    if (!_cp437 && (c >= 176))
+        c++;
+
+    drawGlyph5x7(x, y, c, color, bg);
 }
 
 /**
- * @brief 绘制像素点（重写Adafruit_GFX虚函数）
- * @param x 像素点X坐标
- * @param y 像素点Y坐标
- * @param color 颜色（0:清除, 1:设置）
- *
- * 像素存储格式：
- * - 垂直8像素为一页，MSB在顶部
- * - 帧缓冲区索引：page * 128 + column
- * - 位位置：y % 8
+ * @brief 内置5x7字体字形直接写入帧缓冲区
+ * @param x 字符左上角X坐标
+ * @param y 字符左上角Y坐标
+ * @param c 字符
+ * @param color 前景颜色
+ * @param bg 背景颜色（与color相同时为透明）
  *
- * 优化点：
- * - 快速边界检查
- * - 使用位运算提高效率
- * - 支持多种颜色模式
+ * 字形每列一个字节（bit0在顶部），与页格式一致：
+ * - 列字节左移(y & 7)位得到16位值，低8位写入当前页，高8位写入下一页
+ * - 透明背景：只对字形置位的像素应用前景色
+ * - 不透明背景：前景像素应用color，其余像素应用bg，并补齐第6列背景
+ * - 页对齐且白字黑底（最常见情况）时直接写入字节
  */
-void ST7567_LCD::drawPixel(int16_t x, int16_t y, uint16_t color)
+void ST7567_LCD::drawGlyph5x7(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg)
 {
-    // 边界检查（使用快速比较）
-    if ((x < 0) || (x >= width()) || (y < 0) || (y >= height()))
+    bool opaque = (bg != color);
+    uint8_t columns = opaque ? 6 : 5;
+
+    uint8_t glyph[6];
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        glyph[i] = pgm_read_byte(&font[c * 5 + i]);
+    }
+    glyph[5] = 0x00; // 字符间隔列
+
+    // 向下取整的页号（y可能为负）和页内偏移
+    int16_t page = st7567_floorPage(y);
+    uint8_t shift = y - page * 8;
+
+    // 裁剪列范围
+    int16_t col0 = x < 0 ? -x : 0;
+    int16_t col1 = (x + columns > LCD_WIDTH) ? LCD_WIDTH - x : columns;
+    if (col0 >= col1)
         return;
 
-    // 计算帧缓冲区中的位置
-    uint16_t idx = (y / 8) * LCD_WIDTH + x; // 字节索引
-    uint8_t bit = 1 << (y % 8);             // 位掩码
+    bool upperVisible = pageVisible(page);
+    bool lowerVisible = (shift != 0 && pageVisible(page + 1));
+    if (!upperVisible && !lowerVisible)
+        return; // 页模式下字符不在当前页
+    markDirty(x + col0, x + col1 - 1, upperVisible ? page : page + 1, lowerVisible ? page + 1 : page);
 
-    // 设置或清除指定位
-    if (color)
+    // 页对齐的白字黑底：字形字节直接作为页字节
+    if (shift == 0 && opaque && color == ST7567_WHITE && bg == ST7567_BLACK)
     {
-        frameBuffer[idx] |= bit; // 设置像素
+        memcpy(&pageRow(page)[x + col0], &glyph[col0], col1 - col0);
+        return;
     }
-    else
+
+    for (int16_t i = col0; i < col1; i++)
     {
-        frameBuffer[idx] &= ~bit; // 清除像素
+        blendColumn(x + i, page, shift, glyph[i], 0xFF, color, bg, opaque);
     }
 }
 
 /**
- * @brief 批量写入缓冲区数据到显示屏
- * @param buffer 数据缓冲区指针
- * @param length 数据长度
- *
- * 适用于：
- * - 预先渲染好的图像数据
- * - 从外部存储器加载的图形
- * - 需要绕过帧缓冲区的特殊应用
+ * @brief 将一列8个垂直像素写入帧缓冲区（可能跨两页）
+ * @param x 列坐标（调用者保证在屏幕范围内）
+ * @param page 起始页（可为负或超出范围，超出部分被裁剪）
+ * @param shift 页内偏移（0-7）
+ * @param bits 像素位（bit0对应最上面一行）
+ * @param mask 有效行掩码（不透明模式下掩码内未置位的像素应用背景色）
+ * @param color 前景颜色
+ * @param bg 背景颜色
+ * @param opaque 是否绘制背景
  *
- * 性能优化：
- * - 直接DMA传输（如果支持）
- * - 减少内存拷贝操作
- * - 支持大容量数据传输
+ * 位和掩码左移shift后为16位值，低8位属于page，高8位属于page+1
  */
-void ST7567_LCD::writeBuffer(const uint8_t *buffer, size_t length)
+void ST7567_LCD::blendColumn(int16_t x, int16_t page, uint8_t shift, uint8_t bits, uint8_t mask,
+                             uint16_t color, uint16_t bg, bool opaque)
 {
-    if (length > FRAME_SIZE)
-        length = FRAME_SIZE;
+    uint16_t fg16 = (uint16_t)(bits & mask) << shift;
+    uint16_t bg16 = opaque ? ((uint16_t)(mask & ~bits) << shift) : 0;
 
-    spiBeginTransaction();
-    setAddrWindow(0, 0);           // 设置到显示起始位置
-    writeDataBulk(buffer, length); // 直接写入数据
-    spiEndTransaction();
+    if (pageVisible(page))
+    {
+        uint8_t &dst = pageRow(page)[x];
+        st7567_applyMaskByte(dst, fg16 & 0xFF, color);
+        if (opaque)
+            st7567_applyMaskByte(dst, bg16 & 0xFF, bg);
+    }
+    if (shift != 0 && pageVisible(page + 1))
+    {
+        uint8_t &dst = pageRow(page + 1)[x];
+        st7567_applyMaskByte(dst, fg16 >> 8, color);
+        if (opaque)
+            st7567_applyMaskByte(dst, bg16 >> 8, bg);
+    }
 }
 
 /**
- * @brief 绘制水平线（优化版本）
- * @param x 起始X坐标
- * @param y 起始Y坐标
- * @param w 线宽度
- * @param color 颜色
+ * @brief 输出一个字符并移动光标
+ * @param c 字符
+ * @return 写入的字符数
  *
- * 优化策略：
- * - 使用字节操作代替逐像素绘制
- * - 减少边界检查次数
- * - 支持快速填充模式
+ * 内置字体的换行、自动折行规则与Adafruit_GFX一致，字符绘制走drawChar()快速路径；
+ * 自定义GFXfont交给Adafruit_GFX处理
  */
-void ST7567_LCD::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+size_t ST7567_LCD::write(uint8_t c)
 {
-    // 边界检查和裁剪
-    if (y < 0 || y >= height() || w <= 0)
-        return;
-    if (x < 0)
-    {
-        w += x;
-        x = 0;
-    }
-    if (x + w > width())
+    if (gfxFont != nullptr)
     {
-        w = width() - x;
+        return Adafruit_GFX::write(c);
     }
-    if (w <= 0)
-        return;
-
-    // 计算所在页和位掩码
-    uint8_t page = y / 8;
-    uint8_t bit = 1 << (y % 8);
-    uint8_t *buffer = &frameBuffer[page * LCD_WIDTH + x];
 
-    // 使用memset风格快速填充
-    if (color)
+    if (c == '\n')
     {
-        for (int16_t i = 0; i < w; i++)
-        {
-            buffer[i] |= bit;
-        }
+        cursor_x = 0;
+        cursor_y += textsize_y * 8;
     }
-    else
+    else if (c != '\r')
     {
-        uint8_t mask = ~bit;
-        for (int16_t i = 0; i < w; i++)
+        if (wrap && ((cursor_x + textsize_x * 6) > _width))
         {
-            buffer[i] &= mask;
+            cursor_x = 0;
+            cursor_y += textsize_y * 8;
         }
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+        cursor_x += textsize_x * 6;
     }
+    return 1;
 }
 
 /**
- * @brief 绘制垂直线（优化版本）
- * @param x 起始X坐标
- * @param y 起始Y坐标
- * @param h 线高度
- * @param color 颜色
+ * @brief 8x8位矩阵转置（Hacker's Delight 7-3，64位SWAR）
+ * @param rows 8行源数据，第i行位于第i个字节（bit7为最左列）
+ * @return 8列结果，第j列位于bits[56-8j, 63-8j]，列内bit i对应第i行
  *
- * 优化策略：
- * - 跨页处理优化
- * - 减少页切换次数
- * - 支持快速垂直填充
+ * 三轮交换分别交换1x1、2x2、4x4子块，共9次移位/异或，无分支
  */
-void ST7567_LCD::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+static inline uint64_t transpose8x8(uint64_t x)
 {
-    // 边界检查和裁剪
-    if (x < 0 || x >= width() || h <= 0)
-        return;
-    if (y < 0)
-    {
-        h += y;
-        y = 0;
-    }
-    if (y + h > height())
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
+/**
+ * @brief 行优先1bpp位图块传输到页格式帧缓冲区
+ * @param x 目标左上角X坐标
+ * @param y 目标左上角Y坐标
+ * @param bitmap 位图数据（每行(w+7)/8字节）
+ * @param w 位图宽度
+ * @param h 位图高度
+ * @param color 前景颜色
+ * @param bg 背景颜色（仅BLIT_OPAQUE使用）
+ * @param mode 混合模式
+ * @param lsbFirst true:XBM格式（bit0为最左像素）, false:Adafruit格式（bit7为最左像素）
+ * @param progmem true:位图位于PROGMEM
+ *
+ * 处理流程：
+ * 1. 按8行×8列分块，每块8个源字节打包为64位字并转置，得到8个列字节
+ * 2. 列字节按目标y左移，写入相邻两页（任意y偏移）
+ * 3. 不足8行/8列的边缘块用掩码裁剪
+ */
+void ST7567_LCD::blitRowMajor(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h,
+                              uint16_t color, uint16_t bg, BlitMode mode, bool lsbFirst, bool progmem)
+{
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_BITMAP]++);
+
+    // 旋转后的坐标映射由drawPixel()逐像素处理
+    if (rotation != 0)
     {
-        h = height() - y;
+        blitGeneric(x, y, bitmap, w, h, color, bg, mode, lsbFirst, progmem);
+        return;
     }
-    if (h <= 0)
+
+    if (w <= 0 || h <= 0 || x >= LCD_WIDTH || y > _clipY1 || x + w <= 0 || y + h <= _clipY0)
         return;
 
-    // 计算起始页和结束页
-    uint8_t startPage = y / 8;
-    uint8_t endPage = (y + h - 1) / 8;
-    uint8_t startBit = y % 8;
+    bool opaque = (mode == BLIT_OPAQUE);
+    if (mode == BLIT_XOR)
+        color = ST7567_INVERSE;
 
-    // 单页处理
-    if (startPage == endPage)
-    {
-        uint8_t mask = 0;
-        for (int16_t i = 0; i < h; i++)
-        {
-            mask |= (1 << ((startBit + i) % 8));
-        }
-        if (color)
-        {
-            frameBuffer[startPage * LCD_WIDTH + x] |= mask;
-        }
-        else
-        {
-            frameBuffer[startPage * LCD_WIDTH + x] &= ~mask;
-        }
-    }
-    // 跨页处理
-    else
-    {
-        // 第一页
-        uint8_t firstMask = 0xFF << startBit;
-        if (color)
-        {
-            frameBuffer[startPage * LCD_WIDTH + x] |= firstMask;
-        }
-        else
-        {
-            frameBuffer[startPage * LCD_WIDTH + x] &= ~firstMask;
-        }
+    int16_t byteWidth = (w + 7) / 8;
 
-        // 中间完整页
-        for (uint8_t page = startPage + 1; page < endPage; page++)
+    // 登记裁剪后的脏区域
+    int16_t dx0 = max(x, (int16_t)0);
+    int16_t dx1 = min((int16_t)(x + w - 1), (int16_t)(LCD_WIDTH - 1));
+    int16_t dy0 = max(y, _clipY0);
+    int16_t dy1 = min((int16_t)(y + h - 1), _clipY1);
+    markDirty(dx0, dx1, dy0 / 8, dy1 / 8);
+
+    for (int16_t r0 = 0; r0 < h; r0 += 8)
+    {
+        int16_t ty = y + r0;
+        if (ty + 8 <= _clipY0)
+            continue; // 页模式下跳过当前页之前的行带
+        if (ty > _clipY1)
+            break;
+
+        uint8_t rows = (h - r0) < 8 ? (h - r0) : 8;
+        uint8_t rowMask = 0xFF >> (8 - rows);
+        int16_t page = st7567_floorPage(ty);
+        uint8_t shift = ty - page * 8;
+
+        for (int16_t bx = 0; bx < byteWidth; bx++)
         {
-            if (color)
+            int16_t tx = x + bx * 8;
+            if (tx + 8 <= 0)
+                continue;
+            if (tx >= LCD_WIDTH)
+                break;
+
+            // 打包8行源字节（第i行在第i个字节）
+            uint64_t tile = 0;
+            const uint8_t *src = &bitmap[r0 * byteWidth + bx];
+            for (uint8_t i = 0; i < rows; i++)
             {
-                frameBuffer[page * LCD_WIDTH + x] = 0xFF;
+                uint8_t b = progmem ? pgm_read_byte(src) : *src;
+                tile |= (uint64_t)b << (8 * i);
+                src += byteWidth;
             }
-            else
+            if (tile == 0 && !opaque)
+                continue; // 透明模式下的空白块
+
+            tile = transpose8x8(tile);
+
+            uint8_t cols = (w - bx * 8) < 8 ? (w - bx * 8) : 8;
+            for (uint8_t j = 0; j < cols; j++)
             {
-                frameBuffer[page * LCD_WIDTH + x] = 0x00;
+                int16_t cx = tx + j;
+                if (cx < 0 || cx >= LCD_WIDTH)
+                    continue;
+                uint8_t column = lsbFirst ? (uint8_t)(tile >> (8 * j)) : (uint8_t)(tile >> (56 - 8 * j));
+                blendColumn(cx, page, shift, column, rowMask, color, bg, opaque);
             }
         }
+    }
+}
 
-        // 最后一页
-        uint8_t lastMask = 0xFF >> (7 - ((y + h - 1) % 8));
-        if (color)
-        {
-            frameBuffer[endPage * LCD_WIDTH + x] |= lastMask;
-        }
-        else
+/**
+ * @brief 位图逐像素绘制（旋转时的通用路径）
+ *
+ * 参数同blitRowMajor()
+ */
+void ST7567_LCD::blitGeneric(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h,
+                             uint16_t color, uint16_t bg, BlitMode mode, bool lsbFirst, bool progmem)
+{
+    int16_t byteWidth = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++)
+    {
+        for (int16_t i = 0; i < w; i++)
         {
-            frameBuffer[endPage * LCD_WIDTH + x] &= ~lastMask;
+            const uint8_t *src = &bitmap[j * byteWidth + i / 8];
+            uint8_t b = progmem ? pgm_read_byte(src) : *src;
+            bool set = lsbFirst ? (b & (1 << (i & 7))) : (b & (0x80 >> (i & 7)));
+            if (set)
+                drawPixel(x + i, y + j, mode == BLIT_XOR ? ST7567_INVERSE : color);
+            else if (mode == BLIT_OPAQUE)
+                drawPixel(x + i, y + j, bg);
         }
     }
 }
 
 /**
- * @brief 填充矩形（优化版本）
- * @param x 矩形左上角X坐标
- * @param y 矩形左上角Y坐标
- * @param w 矩形宽度
- * @param h 矩形高度
- * @param color 填充颜色
+ * @brief 绘制PROGMEM位图（透明背景）
+ */
+void ST7567_LCD::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+{
+    blitRowMajor(x, y, bitmap, w, h, color, color, BLIT_TRANSPARENT, false, true);
+}
+
+/**
+ * @brief 绘制PROGMEM位图（不透明背景）
+ */
+void ST7567_LCD::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                            uint16_t color, uint16_t bg)
+{
+    blitRowMajor(x, y, bitmap, w, h, color, bg, BLIT_OPAQUE, false, true);
+}
+
+/**
+ * @brief 绘制RAM位图（透明背景）
+ */
+void ST7567_LCD::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
+{
+    blitRowMajor(x, y, bitmap, w, h, color, color, BLIT_TRANSPARENT, false, false);
+}
+
+/**
+ * @brief 绘制RAM位图（不透明背景）
+ */
+void ST7567_LCD::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                            uint16_t color, uint16_t bg)
+{
+    blitRowMajor(x, y, bitmap, w, h, color, bg, BLIT_OPAQUE, false, false);
+}
+
+/**
+ * @brief 绘制PROGMEM XBM位图（bit0为最左像素，透明背景）
+ */
+void ST7567_LCD::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+{
+    blitRowMajor(x, y, bitmap, w, h, color, color, BLIT_TRANSPARENT, true, true);
+}
+
+/**
+ * @brief 绘制GFXcanvas1画布
+ * @param x 目标左上角X坐标
+ * @param y 目标左上角Y坐标
+ * @param canvas 1bpp画布
+ * @param color 前景颜色
+ * @param bg 背景颜色
+ * @param mode 混合模式
  *
- * 优化特性：
- * - 使用快速水平线算法
- * - 跨页优化处理
- * - 减少重复计算
+ * 画布缓冲区为行优先MSB在左，与drawBitmap格式相同；
+ * 画布设置了旋转时逐像素读取
  */
-void ST7567_LCD::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+void ST7567_LCD::drawCanvas(int16_t x, int16_t y, GFXcanvas1 &canvas, uint16_t color, uint16_t bg, BlitMode mode)
 {
-    // 边界检查和裁剪
-    if (w <= 0 || h <= 0)
-        return;
-    if (x < 0)
-    {
-        w += x;
-        x = 0;
-    }
-    if (y < 0)
-    {
-        h += y;
-        y = 0;
-    }
-    if (x + w > width())
+    if (canvas.getRotation() == 0)
     {
-        w = width() - x;
-    }
-    if (y + h > height())
-    {
-        h = height() - y;
-    }
-    if (w <= 0 || h <= 0)
+        blitRowMajor(x, y, canvas.getBuffer(), canvas.width(), canvas.height(), color, bg, mode, false, false);
         return;
+    }
+
+    ST7567_METRIC(_metrics.drawCalls[ST7567_PRIM_BITMAP]++);
 
-    // 使用优化后的水平线绘制
-    for (int16_t i = y; i < y + h; i++)
+    for (int16_t j = 0; j < canvas.height(); j++)
     {
-        drawFastHLine(x, i, w, color);
+        for (int16_t i = 0; i < canvas.width(); i++)
+        {
+            if (canvas.getPixel(i, j))
+                drawPixel(x + i, y + j, mode == BLIT_XOR ? ST7567_INVERSE : color);
+            else if (mode == BLIT_OPAQUE)
+                drawPixel(x + i, y + j, bg);
+        }
     }
 }
 
@@ -860,9 +2973,8 @@ void ST7567_LCD::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c
  */
 void ST7567_LCD::setSleepMode(bool sleep)
 {
-    spiBeginTransaction();
-    writeCommand(sleep ? 0xAE : 0xAF); // 0xAE:睡眠, 0xAF:唤醒
-    spiEndTransaction();
+    const uint8_t cmd = sleep ? 0xAE : 0xAF; // 0xAE:睡眠, 0xAF:唤醒
+    writeCommands(&cmd, 1);
 }
 
 /**
@@ -876,9 +2988,8 @@ void ST7567_LCD::setSleepMode(bool sleep)
  */
 void ST7567_LCD::setStartLine(uint8_t line)
 {
-    spiBeginTransaction();
-    writeCommand(0x40 | (line & 0x3F)); // 设置显示起始行
-    spiEndTransaction();
+    const uint8_t cmd = 0x40 | (line & 0x3F); // 设置显示起始行
+    writeCommands(&cmd, 1);
 }
 
 /**
@@ -892,9 +3003,8 @@ void ST7567_LCD::setStartLine(uint8_t line)
  */
 void ST7567_LCD::setPageAddress(uint8_t page)
 {
-    spiBeginTransaction();
-    writeCommand(0xB0 | (page & 0x07)); // 设置页地址
-    spiEndTransaction();
+    const uint8_t cmd = 0xB0 | (page & 0x07); // 设置页地址
+    writeCommands(&cmd, 1);
 }
 
 /**
@@ -908,10 +3018,11 @@ void ST7567_LCD::setPageAddress(uint8_t page)
  */
 void ST7567_LCD::setColumnAddress(uint8_t col)
 {
-    spiBeginTransaction();
-    writeCommand(0x10 | ((col >> 4) & 0x0F)); // 设置列地址高4位
-    writeCommand(0x00 | (col & 0x0F));        // 设置列地址低4位
-    spiEndTransaction();
+    const uint8_t cmds[2] = {
+        (uint8_t)(0x10 | ((col >> 4) & 0x0F)), // 设置列地址高4位
+        (uint8_t)(0x00 | (col & 0x0F))         // 设置列地址低4位
+    };
+    writeCommands(cmds, sizeof(cmds));
 }
 
 /**
@@ -973,9 +3084,34 @@ uint32_t ST7567_LCD::performanceTest(uint16_t iterations)
     Serial.printf("Performance Test: %d iterations, avg time: %lu us\n",
                   iterations, avgTime);
 
+    // 理论下限：整帧字节数在当前SPI时钟下的纯传输时间
+    if (_useHardwareSPI && _spi)
+    {
+        Serial.printf("Full frame: %u bytes, wire time @ %lu Hz: %lu us\n",
+                      FULL_FRAME_BYTES, (unsigned long)_spiFrequency,
+                      (unsigned long)estimateTransferTime(FULL_FRAME_BYTES, _spiFrequency));
+    }
+
     return avgTime;
 }
 
+/**
+ * @brief 估算SPI传输时间
+ * @param bytes 传输字节数
+ * @param frequency SPI时钟频率（Hz）
+ * @return 纯线路传输时间（微秒，向上取整）
+ *
+ * 每字节8个时钟周期，不含CS/DC切换和函数调用开销。
+ * 例：整帧FULL_FRAME_BYTES = 1024 + 8*3 = 1048字节，40MHz下约210us
+ */
+uint32_t ST7567_LCD::estimateTransferTime(uint32_t bytes, uint32_t frequency)
+{
+    if (frequency == 0)
+        return 0;
+    uint64_t bits = (uint64_t)bytes * 8 * 1000000UL;
+    return (uint32_t)((bits + frequency - 1) / frequency);
+}
+
 /**
  * @brief 显示测试图案（调试用）
  * @param pattern 测试图案类型
@@ -1056,4 +3192,116 @@ void ST7567_LCD::testPattern(uint8_t pattern)
 uint16_t ST7567_LCD::getFPS()
 {
     return _fps;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 记录一次刷新
+ * @param startUs 刷新开始时的micros()
+ * @param full true:全屏刷新, false:局部刷新
+ *
+ * 耗时写入METRICS_WINDOW大小的环形窗口，旧样本被覆盖
+ */
+void ST7567_LCD::recordFlush(uint32_t startUs, bool full)
+{
+#if ST7567_METRICS
+    _flushSamples[_flushSamplePos] = micros() - startUs;
+    _flushSamplePos = (_flushSamplePos + 1) % METRICS_WINDOW;
+    if (_flushSampleCount < METRICS_WINDOW)
+        _flushSampleCount++;
+
+    if (full)
+        _metrics.fullFlushes++;
+    else
+        _metrics.partialFlushes++;
+#else
+    (void)startUs;
+    (void)full;
+#endif
+}
+
+/**
+ * @brief 获取性能指标快照
+ * @return 指标结构体
+ *
+ * 窗口统计在查询时计算：样本拷贝到栈上插入排序（最多64个），
+ * P99取排序后第ceil(0.99 × n)个样本
+ */
+ST7567_Metrics ST7567_LCD::getMetrics() const
+{
+    ST7567_Metrics m = _metrics;
+
+    uint32_t flushes = m.fullFlushes + m.partialFlushes;
+    m.partialPercent = flushes ? (uint8_t)((uint64_t)m.partialFlushes * 100 / flushes) : 0;
+    m.flushSamples = _flushSampleCount;
+
+    if (_flushSampleCount == 0)
+    {
+        m.flushMinUs = m.flushAvgUs = m.flushMaxUs = m.flushP99Us = 0;
+        return m;
+    }
+
+    uint32_t sorted[METRICS_WINDOW];
+    uint64_t sum = 0;
+    for (uint8_t i = 0; i < _flushSampleCount; i++)
+    {
+        uint32_t v = _flushSamples[i];
+        sum += v;
+        int16_t j = i - 1;
+        while (j >= 0 && sorted[j] > v)
+        {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+
+    uint8_t p99 = (uint8_t)(((uint16_t)_flushSampleCount * 99 + 99) / 100) - 1;
+    m.flushMinUs = sorted[0];
+    m.flushMaxUs = sorted[_flushSampleCount - 1];
+    m.flushAvgUs = (uint32_t)(sum / _flushSampleCount);
+    m.flushP99Us = sorted[p99];
+    return m;
+}
+
+/**
+ * @brief 清零所有性能指标
+ */
+void ST7567_LCD::resetMetrics()
+{
+    memset(&_metrics, 0, sizeof(_metrics));
+    _flushSamplePos = 0;
+    _flushSampleCount = 0;
+}
+
+/**
+ * @brief 输出CSV表头
+ * @param out 输出目标
+ */
+void ST7567_LCD::printMetricsCSVHeader(Print &out)
+{
+    out.println("bytes,cmd_bytes,cs_toggles,dc_toggles,full,partial,partial_pct,"
+                "flush_n,flush_min,flush_avg,flush_max,flush_p99,pixel,hline,vline,fill_rect,char,bitmap,line,shape");
+}
+
+/**
+ * @brief 以一行CSV输出当前性能指标
+ * @param out 输出目标
+ *
+ * 适合定期写入串口日志，离线比较不同界面/版本的传输量和刷新耗时
+ */
+void ST7567_LCD::printMetricsCSV(Print &out) const
+{
+    ST7567_Metrics m = getMetrics();
+    out.printf("%lu,%lu,%lu,%lu,%lu,%lu,%u,%u,%lu,%lu,%lu,%lu",
+               (unsigned long)m.bytesSent, (unsigned long)m.commandBytes,
+               (unsigned long)m.csToggles, (unsigned long)m.dcToggles,
+               (unsigned long)m.fullFlushes, (unsigned long)m.partialFlushes,
+               m.partialPercent, m.flushSamples,
+               (unsigned long)m.flushMinUs, (unsigned long)m.flushAvgUs,
+               (unsigned long)m.flushMaxUs, (unsigned long)m.flushP99Us);
+    for (uint8_t i = 0; i < ST7567_PRIM_COUNT; i++)
+    {
+        out.printf(",%lu", (unsigned long)m.drawCalls[i]);
+    }
+    out.println();
+}
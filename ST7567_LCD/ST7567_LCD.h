@@ -11,8 +11,19 @@
  * 主要优化特性：
  * - 显示刷新性能优化（全屏/局部刷新）
  * - 性能统计和帧率测试
- * - 智能刷新策略（根据区域大小自动选择）
- * - 双缓冲支持，消除画面撕裂
+ * - 运行时性能指标（传输字节、引脚翻转、刷新耗时分布、绘图调用计数），可输出CSV
+ * - 智能刷新策略（自校准代价模型选择局部/合并/全屏刷新）
+ * - 脏区跟踪，只刷新被修改的列区间
+ * - 影子缓冲区差分刷新，相同帧零传输
+ * - 异步刷新：传输引擎在后台发送，CPU继续渲染（ESP32 DMA）
+ * - 常驻双缓冲，指针交换无堆操作，消除画面撕裂
+ * - 软件SPI直接操作GPIO置位/清零寄存器（ESP32/ESP8266）
+ * - 命令/数据批次传输，整帧只拉低一次CS
+ * - 页模式：128字节页缓冲区逐页渲染并发送，省去1KB帧缓冲区
+ * - 内置5x7字体直接按页格式写入（字形列字节即页字节）
+ * - 行优先位图/画布通过8x8位矩阵转置写入页格式
+ * - 直线/圆/三角形/圆角矩形生成跨度后按页掩码写入，页内竖直游程一次完成
+ * - 旋转在图元入口一次映射到物理坐标，竖屏与横屏走相同的页式内核
  * - 内存使用优化和边界检查
  * - 完整的错误处理和调试支持
  *
@@ -51,6 +62,13 @@
 #include <Adafruit_GFX.h> // Adafruit图形库基类
 #include <SPI.h>          // ESP32 SPI库
 #include <Arduino.h>      // Arduino基础库
+#include "ST7567_FlushEngine.h" // 异步刷新传输引擎接口
+#include "ST7567_Metrics.h"     // 运行时性能指标
+
+// 颜色定义
+#define ST7567_BLACK 0   ///< 清除像素
+#define ST7567_WHITE 1   ///< 点亮像素
+#define ST7567_INVERSE 2 ///< 反转像素
 
 class ST7567_LCD : public Adafruit_GFX
 {
@@ -59,6 +77,53 @@ public:
     static const uint16_t LCD_WIDTH = 128;     ///< 显示屏宽度（像素）
     static const uint16_t LCD_HEIGHT = 64;     ///< 显示屏高度（像素）
     static const uint16_t FRAME_SIZE = (LCD_WIDTH * LCD_HEIGHT / 8); ///< 帧缓冲区大小（字节）
+    static const uint8_t PAGE_COUNT = (LCD_HEIGHT / 8);              ///< 显示页数（每页8行）
+    /**
+     * @brief 位图混合模式
+     */
+    enum BlitMode
+    {
+        BLIT_TRANSPARENT, ///< 置位像素应用前景色，其余不变
+        BLIT_OPAQUE,      ///< 置位像素应用前景色，其余应用背景色
+        BLIT_XOR          ///< 置位像素反转
+    };
+
+    /**
+     * @brief 页模式绘制回调
+     * @param lcd 显示屏驱动
+     * @param clipTop 当前页的第一行
+     * @param clipBottom 当前页的最后一行（包含）
+     * @param context 用户上下文
+     */
+    typedef void (*PageRenderCallback)(ST7567_LCD &lcd, int16_t clipTop, int16_t clipBottom, void *context);
+
+    /**
+     * @brief 双缓冲交换后后台缓冲区的处理方式
+     */
+    enum SwapMode
+    {
+        SWAP_KEEP,  ///< 保持不变（内容为两帧之前，适合每帧完整重绘）
+        SWAP_COPY,  ///< 复制刚显示的帧（适合增量绘制，默认）
+        SWAP_CLEAR  ///< 清零
+    };
+
+    /**
+     * @brief refreshRegion()选择的刷新策略
+     */
+    enum FlushStrategy
+    {
+        FLUSH_NONE,   ///< 区域无效，未传输
+        FLUSH_REGION, ///< 只发送区域覆盖的各页列区间
+        FLUSH_MERGED, ///< 区域与同页待刷新脏区合并后发送
+        FLUSH_FULL    ///< 全屏刷新
+    };
+
+    static const uint8_t ADDR_CMD_BYTES = 3;                         ///< 每次设置地址窗口的命令字节数
+    static const uint16_t FULL_FRAME_BYTES = FRAME_SIZE + PAGE_COUNT * ADDR_CMD_BYTES; ///< 全屏刷新总字节数（数据+地址命令）
+    static const uint8_t SHADOW_MERGE_GAP = 8;                       ///< 差分刷新合并间隙（字节，约等于一次地址设置的开销）
+    static const uint16_t SEGMENT_OVERHEAD_NS = 2000;                ///< 默认每段固定开销（DC切换+地址命令调用，未校准时使用）
+    static const uint8_t METRICS_WINDOW = 64;                        ///< 刷新耗时统计窗口（最近N次刷新）
+    static const uint16_t SOFT_SPI_BYTE_NS = 1000;                   ///< 软件SPI默认每字节耗时（未校准时使用）
 
     /**
      * @brief 硬件SPI构造函数
@@ -77,6 +142,9 @@ public:
      * @param dc   数据/命令选择引脚
      * @param sclk 时钟引脚
      * @param mosi 数据输入引脚
+     * 
+     * @note ESP32/ESP8266上自动改用GPIO置位/清零寄存器直写，每字节8位展开，
+     * 速度接近硬件SPI；其他平台使用shiftOut()
      */
     ST7567_LCD(int8_t cs, int8_t rst, int8_t dc, int8_t sclk, int8_t mosi);
 
@@ -108,6 +176,101 @@ public:
      */
     void display();
 
+    /**
+     * @brief 异步全屏刷新（非阻塞）
+     * @return true:已提交到传输引擎, false:未设置引擎，已退化为同步display()
+     * 
+     * 帧缓冲区快照后立即返回，8页的地址命令和数据作为DMA分段在后台发送，
+     * 返回后即可继续在帧缓冲区中绘制下一帧
+     */
+    bool displayAsync();
+
+    /**
+     * @brief 查询异步刷新是否仍在进行
+     * @return true:传输进行中
+     */
+    bool isFlushBusy();
+
+    /**
+     * @brief 阻塞等待异步刷新完成
+     * 
+     * @note 所有同步写入（命令、display()等）开始前会自动等待
+     */
+    void waitFlush();
+
+    /**
+     * @brief 设置异步传输引擎
+     * @param engine 传输引擎指针（nullptr:使用SPIClass/软件SPI同步传输）
+     * 
+     * 引擎接管SPI总线后，同步命令也经由引擎发送。建议在begin()之前调用
+     */
+    void setFlushEngine(ST7567_FlushEngine *engine);
+
+    /**
+     * @brief 设置异步刷新完成回调
+     * @param callback 回调函数（nullptr取消）
+     * @param context 传给回调的用户上下文
+     * 
+     * @note ESP32 DMA引擎在中断上下文中调用回调
+     */
+    void setFlushCallback(ST7567_FlushCallback callback, void *context = nullptr);
+
+    /**
+     * @brief 启用/关闭影子缓冲区差分刷新
+     * @param enable true:启用, false:关闭并释放影子缓冲区
+     * 
+     * 影子缓冲区（1KB）保存最近一次发送到控制器的内容，启用后display()
+     * 按32位字逐页比较帧缓冲区与影子缓冲区，只发送不同的列区间：
+     * - 能捕获通过getFrameBuffer()直接写入的修改
+     * - 与上一帧完全相同的帧不产生任何传输
+     * - 间隙小于SHADOW_MERGE_GAP的相邻区间合并发送，节省地址设置命令
+     */
+    void setShadowBuffer(bool enable);
+
+    /**
+     * @brief 使影子缓冲区失效，下一次display()强制全屏刷新
+     * 
+     * @note 在绕过驱动直接操作显示RAM后调用
+     */
+    void invalidateShadow() { _shadowValid = false; }
+
+    /**
+     * @brief 只刷新脏区域（增量刷新）
+     * 
+     * 优化特性：
+     * - 绘图函数自动记录每页被修改的列范围
+     * - 只发送各页脏列区间，未修改的页完全跳过
+     * - 刷新完成后清除脏区记录
+     * 
+     * @note 通过getFrameBuffer()直接修改缓冲区时，需调用markDirtyRegion()登记
+     */
+    void displayDirty();
+
+    /**
+     * @brief 登记脏区域（直接修改帧缓冲区后使用）
+     * @param x 起始X坐标
+     * @param y 起始Y坐标
+     * @param w 区域宽度
+     * @param h 区域高度
+     */
+    void markDirtyRegion(int16_t x, int16_t y, int16_t w, int16_t h);
+
+    /**
+     * @brief 将整个屏幕标记为脏区域
+     */
+    void markAllDirty();
+
+    /**
+     * @brief 清除所有脏区记录（不刷新显示）
+     */
+    void clearDirty();
+
+    /**
+     * @brief 查询是否存在待刷新的脏区域
+     * @return true:存在脏区域, false:显示内容已同步
+     */
+    bool isDirty() const;
+
     /**
      * @brief 智能局部刷新函数
      * @param x 起始X坐标（0-127）
@@ -115,12 +278,51 @@ public:
      * @param width 刷新区域宽度
      * @param height 刷新区域高度
      * 
+     * @return 实际采用的刷新策略
+     * 
      * 智能特性：
      * - 自动边界检查和区域裁剪
-     * - 根据区域大小自动选择刷新策略
-     * - 跨页区域的连续刷新优化
+     * - 按刷新代价模型（每段开销 + 每字节开销）选择逐页局部、合并脏区或全屏刷新
+     * - 光标、状态图标等小区域只发送所在页的列区间，不会触发全屏传输
+     */
+    FlushStrategy refreshRegion(int16_t x, int16_t y, uint16_t width, uint16_t height);
+
+    /**
+     * @brief 测量刷新代价模型参数（begin()中自动调用）
+     * @return true:测量成功, false:计时精度不足，保留原参数
+     * 
+     * 在一次批次内分别重复发送1字节和128字节的页段，由两者耗时之差得到每字节开销，
+     * 再扣除得到每段固定开销（地址命令、DC切换和调用开销）。
+     * 发送的是帧缓冲区第0页的当前内容，不改变显示
+     */
+    bool calibrateFlushCost();
+
+    /**
+     * @brief 手动设置刷新代价模型参数
+     * @param segmentNs 每段固定开销（纳秒）
+     * @param byteNs 每数据字节开销（纳秒）
+     * 
+     * 设置后begin()不再自动校准
+     */
+    void setFlushCost(uint32_t segmentNs, uint32_t byteNs);
+
+    /**
+     * @brief 获取每段固定开销
+     * @return 纳秒
+     */
+    uint32_t getSegmentCost() const { return _segmentCostNs; }
+
+    /**
+     * @brief 获取每数据字节开销
+     * @return 纳秒
+     */
+    uint32_t getByteCost() const { return _byteCostNs; }
+
+    /**
+     * @brief 获取最近一次refreshRegion()采用的刷新策略
+     * @return 刷新策略
      */
-    void refreshRegion(int16_t x, int16_t y, uint16_t width, uint16_t height);
+    FlushStrategy getLastFlushStrategy() const { return _lastStrategy; }
 
     /**
      * @brief 清空帧缓冲区（不立即显示）
@@ -168,15 +370,47 @@ public:
 
     /**
      * @brief 双缓冲切换显示
-     * @param newBuffer 新帧缓冲区指针（为nullptr时自动创建）
+     * @param newBuffer 新帧缓冲区指针（为nullptr时使用常驻双缓冲交换）
      * 
      * 双缓冲优势：
      * - 消除画面撕裂
      * - 提高渲染流畅度
      * - 支持后台渲染
+     * 
+     * @note newBuffer非空时驱动接管其所有权（需以new[]分配），原缓冲区被释放
      */
     void swapBuffers(uint8_t* newBuffer = nullptr);
 
+    /**
+     * @brief 常驻双缓冲交换（O(1)指针交换，无堆操作）
+     * @param mode 交换后后台缓冲区的处理方式
+     * 
+     * 前台缓冲区被发送到显示屏（有传输引擎时异步发送、无需快照），
+     * 后台缓冲区成为新的绘制目标。首次调用时自动启用双缓冲
+     */
+    void swapBuffers(SwapMode mode);
+
+    /**
+     * @brief 启用/关闭常驻双缓冲
+     * @param enable true:分配前台缓冲区（仅一次）, false:释放
+     */
+    void setDoubleBuffer(bool enable);
+
+    /**
+     * @brief 以外部缓冲区作为绘制目标（不接管所有权）
+     * @param buffer 外部帧缓冲区（FRAME_SIZE字节），nullptr恢复驱动自有缓冲区
+     * 
+     * 恢复时把当前内容复制回自有缓冲区。外部缓冲区在恢复之前必须保持有效；
+     * 页模式或常驻双缓冲启用时不起作用
+     */
+    void attachFrameBuffer(uint8_t *buffer);
+
+    /**
+     * @brief 设置swapBuffers(nullptr)使用的默认交换方式
+     * @param mode 交换方式（默认SWAP_COPY）
+     */
+    void setSwapMode(SwapMode mode) { _swapMode = mode; }
+
     /**
      * @brief 设置睡眠模式
      * @param sleep true:进入睡眠, false:退出睡眠
@@ -212,11 +446,13 @@ public:
     void setColumnAddress(uint8_t col);
 
     // 图形绘制函数（重写Adafruit_GFX）
+    // 均支持setRotation()：旋转在每个图元入口映射一次（不逐像素判断），之后走与旋转0相同的物理页内核，
+    // 例如旋转1/3时drawFastHLine()是页式竖直写入、drawFastVLine()是同页32位字写入
     /**
      * @brief 绘制像素点（重写Adafruit_GFX虚函数）
      * @param x 像素点X坐标
      * @param y 像素点Y坐标
-     * @param color 颜色（0:清除, 1:设置）
+     * @param color 颜色（ST7567_BLACK:清除, ST7567_WHITE:设置, ST7567_INVERSE:反转）
      */
     void drawPixel(int16_t x, int16_t y, uint16_t color) override;
 
@@ -239,7 +475,7 @@ public:
     void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
 
     /**
-     * @brief 填充矩形（优化版本）
+     * @brief 填充矩形（页式内核，支持设置/清除/反转）
      * @param x 矩形左上角X坐标
      * @param y 矩形左上角Y坐标
      * @param w 矩形宽度
@@ -248,6 +484,216 @@ public:
      */
     void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
 
+    // 几何图形（按列/行生成跨度，整页掩码写入）
+    /**
+     * @brief 绘制直线（Bresenham，按游程写入）
+     * @param x0 起点X坐标
+     * @param y0 起点Y坐标
+     * @param x1 终点X坐标
+     * @param y1 终点Y坐标
+     * @param color 颜色
+     *
+     * 像素集合与Adafruit_GFX::writeLine()相同：陡峭的线每列一段竖直游程，
+     * 同一页内的游程合成一次掩码写入；平缓的线每行一段水平游程
+     */
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) override;
+
+    /**
+     * @brief 绘制圆（隐藏Adafruit_GFX的逐像素实现）
+     * @param x0 圆心X坐标
+     * @param y0 圆心Y坐标
+     * @param r 半径
+     * @param color 颜色
+     *
+     * 中点圆算法的轮廓按列归并为竖直游程，每个像素只写一次（ST7567_INVERSE结果正确）
+     */
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+
+    /**
+     * @brief 填充圆（每列一段竖直跨度）
+     * @param x0 圆心X坐标
+     * @param y0 圆心Y坐标
+     * @param r 半径
+     * @param color 颜色
+     */
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+
+    /**
+     * @brief 填充三角形（同一页的扫描线合并为列掩码后一次写入）
+     * @param x0 顶点0 X坐标
+     * @param y0 顶点0 Y坐标
+     * @param x1 顶点1 X坐标
+     * @param y1 顶点1 Y坐标
+     * @param x2 顶点2 X坐标
+     * @param y2 顶点2 Y坐标
+     * @param color 颜色
+     */
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+
+    /**
+     * @brief 填充圆角矩形（中间为矩形内核，两侧圆角每列一段竖直跨度）
+     * @param x 左上角X坐标
+     * @param y 左上角Y坐标
+     * @param w 宽度
+     * @param h 高度
+     * @param r 圆角半径（超过短边一半时取短边一半）
+     * @param color 颜色
+     */
+    void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+
+    // 文本绘制（重写Adafruit_GFX）
+    /**
+     * @brief 绘制字符（内置5x7字体快速路径）
+     * @param x 字符左上角X坐标
+     * @param y 字符左上角Y坐标
+     * @param c 字符
+     * @param color 前景颜色
+     * @param bg 背景颜色（与color相同时为透明背景）
+     * @param size 放大倍数
+     * 
+     * 内置字体每列一个字节、LSB在上，与帧缓冲区的页格式一致：
+     * - 页对齐（y % 8 == 0）时为5~6字节直接写入
+     * - 非对齐时每列移位后写入相邻两页
+     * - 放大、自定义GFXfont时走Adafruit_GFX通用路径
+     */
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+
+    /**
+     * @brief 绘制字符（可分别指定X/Y放大倍数）
+     * @param x 字符左上角X坐标
+     * @param y 字符左上角Y坐标
+     * @param c 字符
+     * @param color 前景颜色
+     * @param bg 背景颜色
+     * @param size_x X方向放大倍数
+     * @param size_y Y方向放大倍数
+     */
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                  uint8_t size_x, uint8_t size_y);
+
+    /**
+     * @brief 输出一个字符并移动光标（print()/println()的底层接口）
+     * @param c 字符
+     * @return 写入的字符数
+     */
+    using Adafruit_GFX::write;
+    size_t write(uint8_t c) override;
+
+    // 位图绘制（隐藏Adafruit_GFX的逐像素实现）
+    /**
+     * @brief 绘制PROGMEM位图（行优先，MSB为最左像素，透明背景）
+     * @param x 左上角X坐标
+     * @param y 左上角Y坐标
+     * @param bitmap 位图数据
+     * @param w 宽度
+     * @param h 高度
+     * @param color 前景颜色
+     */
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color);
+
+    /**
+     * @brief 绘制PROGMEM位图（不透明背景）
+     * @param bg 背景颜色
+     */
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg);
+
+    /**
+     * @brief 绘制RAM位图（透明背景）
+     */
+    void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
+
+    /**
+     * @brief 绘制RAM位图（不透明背景）
+     */
+    void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg);
+
+    /**
+     * @brief 绘制PROGMEM XBM位图（bit0为最左像素，透明背景）
+     */
+    void drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color);
+
+    /**
+     * @brief 绘制GFXcanvas1画布
+     * @param x 左上角X坐标
+     * @param y 左上角Y坐标
+     * @param canvas 1bpp画布
+     * @param color 前景颜色
+     * @param bg 背景颜色（仅BLIT_OPAQUE使用）
+     * @param mode 混合模式
+     */
+    void drawCanvas(int16_t x, int16_t y, GFXcanvas1 &canvas, uint16_t color = ST7567_WHITE,
+                    uint16_t bg = ST7567_BLACK, BlitMode mode = BLIT_OPAQUE);
+
+    /**
+     * @brief 行优先1bpp位图块传输（8x8 SWAR转置）
+     * @param x 左上角X坐标（任意，可部分在屏幕外）
+     * @param y 左上角Y坐标（任意，跨页时自动移位）
+     * @param bitmap 位图数据（每行(w+7)/8字节）
+     * @param w 宽度
+     * @param h 高度
+     * @param color 前景颜色
+     * @param bg 背景颜色（仅BLIT_OPAQUE使用）
+     * @param mode 混合模式（透明/不透明/异或）
+     * @param lsbFirst true:XBM位序（bit0在左）
+     * @param progmem true:数据位于PROGMEM
+     * 
+     * 每8x8块只需8次读取和一次64位转置，整屏位图传输受内存带宽而非函数调用限制
+     */
+    void blitRowMajor(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h,
+                      uint16_t color, uint16_t bg, BlitMode mode, bool lsbFirst = false, bool progmem = false);
+
+    // 批量命令/数据传输
+    /**
+     * @brief 批量发送命令（单次CS有效期）
+     * @param cmds 命令字节数组
+     * @param len 命令字节数
+     */
+    void writeCommands(const uint8_t *cmds, size_t len);
+
+    /**
+     * @brief 开始命令/数据批次
+     * 
+     * 批次内CS保持低电平，DC只在命令/数据边界切换。支持嵌套。
+     * 
+     * 使用示例：
+     * @code
+     * lcd.beginBatch();
+     * lcd.batchCommands(addr, 3);     // 页/列地址
+     * lcd.batchData(pixels, 16);      // 显示数据
+     * lcd.batchCommands(&startLine, 1);
+     * lcd.endBatch();
+     * @endcode
+     * 
+     * @note 批次内不要调用waitFlush()或其他会等待异步刷新的函数
+     */
+    void beginBatch();
+
+    /**
+     * @brief 结束命令/数据批次（最外层时拉高CS）
+     */
+    void endBatch();
+
+    /**
+     * @brief 在批次中发送命令字节（DC低）
+     * @param cmds 命令字节数组
+     * @param len 字节数
+     */
+    void batchCommands(const uint8_t *cmds, size_t len);
+
+    /**
+     * @brief 在批次中发送显示数据（DC高）
+     * @param data 数据指针
+     * @param len 字节数
+     */
+    void batchData(const uint8_t *data, size_t len);
+
+    /**
+     * @brief 在批次中重复发送同一数据字节（DC高）
+     * @param pattern 填充字节
+     * @param count 重复次数
+     */
+    void batchPattern(uint8_t pattern, size_t count);
+
     // 数据操作函数
     /**
      * @brief 批量写入缓冲区数据到显示屏
@@ -269,7 +715,33 @@ public:
      * @brief 获取帧缓冲区大小
      * @return 帧缓冲区大小（字节）
      */
-    size_t getFrameBufferSize() { return FRAME_SIZE; }
+    size_t getFrameBufferSize() { return _pageMode ? LCD_WIDTH : FRAME_SIZE; }
+
+    /**
+     * @brief 启用/关闭页模式（节省896字节RAM）
+     * @param enable true:只保留128字节页缓冲区, false:恢复1KB帧缓冲区
+     * 
+     * 页模式下display()/displayDirty()/refreshRegion()/swapBuffers()不起作用，
+     * 通过renderPaged()绘制并刷新；建议在begin()之前调用
+     */
+    void setPageMode(bool enable);
+
+    /**
+     * @brief 是否处于页模式
+     * @return true:页模式
+     */
+    bool isPageMode() const { return _pageMode; }
+
+    /**
+     * @brief 页模式渲染并刷新一帧
+     * @param draw 绘制回调（依次为8页各调用一次）
+     * @param context 传给回调的用户上下文
+     * 
+     * 每次回调时绘图函数被裁剪到当前页的8行，渲染完成后立即发送该页；
+     * 用CPU时间（整帧绘制8遍）换取896字节RAM。设置了传输引擎时，
+     * 页的发送与下一页的渲染重叠（额外128字节）
+     */
+    void renderPaged(PageRenderCallback draw, void *context = nullptr);
 
     // 调试和测试函数
     /**
@@ -287,6 +759,16 @@ public:
      */
     uint32_t performanceTest(uint16_t iterations = 1);
 
+    /**
+     * @brief 估算SPI传输时间（不依赖硬件，可在主机上验证）
+     * @param bytes 传输字节数
+     * @param frequency SPI时钟频率（Hz）
+     * @return 纯线路传输时间（微秒）
+     * 
+     * 例：estimateTransferTime(FULL_FRAME_BYTES, 40000000) = 210us
+     */
+    static uint32_t estimateTransferTime(uint32_t bytes, uint32_t frequency);
+
     /**
      * @brief 显示测试图案（调试用）
      * @param pattern 测试图案类型
@@ -305,39 +787,390 @@ public:
      */
     uint16_t getFPS();
 
+    /**
+     * @brief 获取性能指标快照
+     * @return 指标结构体（刷新耗时统计基于最近METRICS_WINDOW次刷新）
+     */
+    ST7567_Metrics getMetrics() const;
+
+    /**
+     * @brief 清零所有性能指标
+     */
+    void resetMetrics();
+
+    /**
+     * @brief 输出CSV表头（与printMetricsCSV()的列一一对应）
+     * @param out 输出目标（如Serial）
+     */
+    static void printMetricsCSVHeader(Print &out);
+
+    /**
+     * @brief 以一行CSV输出当前性能指标
+     * @param out 输出目标（如Serial）
+     * 
+     * 列：bytes,cmd_bytes,cs_toggles,dc_toggles,full,partial,partial_pct,
+     * flush_n,flush_min,flush_avg,flush_max,flush_p99,pixel,hline,vline,fill_rect,char,bitmap,line,shape
+     */
+    void printMetricsCSV(Print &out) const;
+
+protected:
+    /**
+     * @brief 硬件SPI构造函数（指定帧缓冲区，供ST7567_LCDT使用）
+     * @param buffer 静态帧缓冲区（FRAME_SIZE字节，4字节对齐，驱动不释放）；nullptr时从堆分配
+     */
+    ST7567_LCD(uint8_t *buffer, int8_t cs, int8_t rst, int8_t dc, SPIClass &spi, uint32_t frequency);
+
+    /**
+     * @brief 软件SPI构造函数（指定帧缓冲区，供ST7567_LCDT使用）
+     * @param buffer 静态帧缓冲区（FRAME_SIZE字节，4字节对齐，驱动不释放）；nullptr时从堆分配
+     */
+    ST7567_LCD(uint8_t *buffer, int8_t cs, int8_t rst, int8_t dc, int8_t sclk, int8_t mosi);
+
 private:
+    friend class ST7567_Terminal;  // 终端模式直接按显示RAM页写入并发送
+    friend class ST7567_FlushTask; // 后台任务直接发送已提交的缓冲区
+    friend class ST7567_TextGrid;  // 字符网格按单元直接光栅化字形
+    friend class ST7567_Grayscale; // 灰度子帧直接按页写入显示RAM
+    friend class ST7567_Surface;   // 离屏表面使用相同的旋转映射
+
     // 私有方法
     /**
-     * @brief 写入命令字节
-     * @param cmd 命令字节
+     * @brief 设置DC电平（与当前电平相同时不操作引脚）
+     * @param level LOW:命令, HIGH:数据
      */
-    void writeCommand(uint8_t cmd);
+    void setDCMode(uint8_t level);
 
     /**
-     * @brief 写入单字节数据
-     * @param data 数据字节
+     * @brief 写入一页中的连续列数据（地址命令+数据，需在批次中调用）
+     * @param page 页地址（0-7）
+     * @param col 起始列地址
+     * @param data 数据指针
+     * @param len 数据长度
      */
-    void writeData(uint8_t data);
+    void writePage(uint8_t page, uint8_t col, const uint8_t *data, size_t len);
 
     /**
-     * @brief 批量写入数据
-     * @param data 数据缓冲区指针
+     * @brief 块传输原始字节（不操作CS/DC）
+     * @param data 数据指针
      * @param len 数据长度
      */
-    void writeDataBulk(const uint8_t *data, size_t len);
+    void spiWrite(const uint8_t *data, size_t len);
 
     /**
-     * @brief 设置显示地址窗口
-     * @param page 页地址（0-7）
-     * @param col 列地址（0-131）
+     * @brief 块传输原始字节（不计入性能指标）
+     * @param data 数据指针
+     * @param len 数据长度
+     */
+    void spiWriteRaw(const uint8_t *data, size_t len);
+
+    /**
+     * @brief 重复发送同一字节（不操作CS/DC）
+     * @param pattern 填充字节
+     * @param count 重复次数
+     */
+    void spiWritePattern(uint8_t pattern, size_t count);
+
+    /**
+     * @brief 缓存软件SPI引脚的GPIO置位/清零寄存器和掩码
+     * 
+     * 平台支持寄存器直写且引脚有效时启用_fastSoftSPI，否则保留shiftOut()
      */
-    void setAddrWindow(uint8_t page, uint8_t col);
+    void initSoftSPIPort();
+
+    /**
+     * @brief 软件SPI发送一个字节（寄存器直写，8位展开，SPI模式0，MSB优先）
+     * @param b 数据字节
+     */
+    void softSPIWriteByte(uint8_t b);
 
     /**
      * @brief 初始化显示屏控制器
      */
     void initDisplay();
 
+    /**
+     * @brief 内置5x7字体字形直接写入帧缓冲区（1倍大小、无旋转）
+     * @param x 字符左上角X坐标
+     * @param y 字符左上角Y坐标
+     * @param c 字符（已完成cp437修正）
+     * @param color 前景颜色
+     * @param bg 背景颜色（与color相同时为透明）
+     */
+    void drawGlyph5x7(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg);
+
+    /**
+     * @brief 将一列8个垂直像素写入帧缓冲区（可能跨两页，自动裁剪页）
+     * @param x 列坐标（需在屏幕范围内）
+     * @param page 起始页（可超出范围）
+     * @param shift 页内偏移（0-7）
+     * @param bits 像素位（bit0在上）
+     * @param mask 有效行掩码
+     * @param color 前景颜色
+     * @param bg 背景颜色
+     * @param opaque 是否绘制背景
+     */
+    void blendColumn(int16_t x, int16_t page, uint8_t shift, uint8_t bits, uint8_t mask,
+                     uint16_t color, uint16_t bg, bool opaque);
+
+    /**
+     * @brief 位图逐像素绘制（旋转时使用）
+     */
+    void blitGeneric(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h,
+                     uint16_t color, uint16_t bg, BlitMode mode, bool lsbFirst, bool progmem);
+
+    /**
+     * @brief 逻辑坐标映射为物理坐标（rotation != 0时调用）
+     * @param rotation 旋转（0-3）
+     * @param x X坐标（输入逻辑坐标，输出物理列）
+     * @param y Y坐标（输入逻辑坐标，输出物理行）
+     *
+     * 与Adafruit_GFX的约定相同：1为顺时针90°，2为180°，3为270°
+     */
+    static inline void rotatePoint(uint8_t rotation, int16_t &x, int16_t &y)
+    {
+        int16_t t;
+        switch (rotation)
+        {
+        case 1:
+            t = x;
+            x = LCD_WIDTH - 1 - y;
+            y = t;
+            break;
+        case 2:
+            x = LCD_WIDTH - 1 - x;
+            y = LCD_HEIGHT - 1 - y;
+            break;
+        case 3:
+            t = x;
+            x = y;
+            y = LCD_HEIGHT - 1 - t;
+            break;
+        }
+    }
+
+    /**
+     * @brief 逻辑矩形映射为物理矩形（rotation != 0时调用，旋转1/3时宽高互换）
+     */
+    static inline void rotateRect(uint8_t rotation, int16_t &x, int16_t &y, int16_t &w, int16_t &h)
+    {
+        int16_t t;
+        switch (rotation)
+        {
+        case 1:
+            t = x;
+            x = LCD_WIDTH - y - h;
+            y = t;
+            t = w;
+            w = h;
+            h = t;
+            break;
+        case 2:
+            x = LCD_WIDTH - x - w;
+            y = LCD_HEIGHT - y - h;
+            break;
+        case 3:
+            t = x;
+            x = y;
+            y = LCD_HEIGHT - t - w;
+            t = w;
+            w = h;
+            h = t;
+            break;
+        }
+    }
+
+    /**
+     * @brief 按当前旋转写入逻辑水平跨度（switch在每段跨度只执行一次）
+     */
+    void rotatedSpanH(int16_t x, int16_t y, int16_t w, uint16_t color);
+
+    /**
+     * @brief 按当前旋转写入逻辑竖直跨度
+     */
+    void rotatedSpanV(int16_t x, int16_t y, int16_t h, uint16_t color);
+
+    /**
+     * @brief 写入水平跨度（物理坐标；裁剪、登记脏区，不计入绘图统计）
+     * @param x0 起始列
+     * @param x1 结束列（包含）
+     * @param y 行
+     */
+    void writeSpanH(int16_t x0, int16_t x1, int16_t y, uint16_t color);
+
+    /**
+     * @brief 写入竖直跨度（物理坐标；裁剪、登记脏区，不计入绘图统计）
+     * @param x 列
+     * @param y0 起始行
+     * @param y1 结束行（包含）
+     *
+     * 同一页内的部分只做一次掩码写入
+     */
+    void writeSpanV(int16_t x, int16_t y0, int16_t y1, uint16_t color);
+
+    /**
+     * @brief 写入矩形（物理坐标；裁剪、登记脏区，不计入绘图统计）
+     */
+    void writeRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+    /**
+     * @brief 按列生成圆/圆角的跨度
+     * @param x0 圆心X坐标
+     * @param y0 圆心Y坐标
+     * @param r 半径
+     * @param corners 1:右半边, 2:左半边, 3:整圆（含圆心所在列）
+     * @param delta 填充时下半部分额外延伸的行数（圆角矩形的直边）
+     * @param fill true:填充, false:只画轮廓
+     */
+    void circleSpans(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, bool fill, uint16_t color);
+
+    /**
+     * @brief 写入圆的一列（circleSpans()内部使用）
+     * @param c 到圆心的列距离
+     * @param lo 该列轮廓到圆心的最小行距离
+     * @param hi 该列轮廓到圆心的最大行距离
+     */
+    void circleColumn(int16_t x0, int16_t y0, int16_t c, int16_t lo, int16_t hi,
+                      uint8_t corners, int16_t delta, bool fill, uint16_t color);
+
+    /**
+     * @brief 一页内累积的列掩码（同页多条水平跨度合并后一次写入）
+     */
+    struct SpanBand
+    {
+        uint8_t mask[LCD_WIDTH]; ///< 各列的行掩码
+        int16_t page;            ///< 所在页（-1:空）
+        int16_t x0;              ///< 起始列
+        int16_t x1;              ///< 结束列（包含）
+    };
+
+    /**
+     * @brief 写入三角形的一条扫描线（逻辑坐标，按旋转映射）
+     */
+    void triangleRow(SpanBand &band, int16_t a, int16_t b, int16_t y, uint16_t color);
+
+    /**
+     * @brief 把一条水平跨度并入页掩码（换页时先写入上一页）
+     */
+    void bandSpan(SpanBand &band, int16_t x0, int16_t x1, int16_t y, uint16_t color);
+
+    /**
+     * @brief 把页掩码写入帧缓冲区并清空
+     */
+    void bandFlush(SpanBand &band, uint16_t color);
+
+    /**
+     * @brief 页在缓冲区中的起始地址（页模式下缓冲区只含当前页）
+     * @param page 页号（需在裁剪窗口内）
+     */
+    inline uint8_t *pageRow(uint8_t page)
+    {
+        return frameBuffer + (page - _bufferPage) * LCD_WIDTH;
+    }
+
+    /**
+     * @brief 页是否在裁剪窗口内
+     * @param page 页号（可为负）
+     */
+    inline bool pageVisible(int16_t page) const
+    {
+        return page >= (_clipY0 >> 3) && page <= (_clipY1 >> 3);
+    }
+
+    /**
+     * @brief 记录脏区域（内部使用，坐标需已裁剪）
+     * @param x0 起始列
+     * @param x1 结束列（包含）
+     * @param page0 起始页
+     * @param page1 结束页（包含）
+     */
+    inline void markDirty(int16_t x0, int16_t x1, uint8_t page0, uint8_t page1)
+    {
+        for (uint8_t page = page0; page <= page1; page++)
+        {
+            if (x0 < _dirtyX0[page])
+                _dirtyX0[page] = x0;
+            if (x1 > _dirtyX1[page])
+                _dirtyX1[page] = x1;
+        }
+    }
+
+    /**
+     * @brief 更新帧率统计
+     */
+    void updateFrameStats();
+
+    /**
+     * @brief 设置初始帧缓冲区（静态缓冲区清零后直接使用，否则从堆分配）
+     */
+    void initFrameBuffer(uint8_t *buffer);
+
+    /**
+     * @brief 释放驱动拥有的整帧缓冲区（静态缓冲区不释放）
+     */
+    void releaseFrameBuffer(uint8_t *buffer);
+
+    /**
+     * @brief 同步刷新指定缓冲区的整帧内容
+     * @param buffer 帧数据
+     */
+    void flushFrame(const uint8_t *buffer);
+
+    /**
+     * @brief 将整帧提交给传输引擎（异步）
+     * @param buffer 帧数据（传输完成前不得修改）
+     * @return true:已提交
+     */
+    bool submitFrame(const uint8_t *buffer);
+
+    /**
+     * @brief 发送整帧，不修改脏区记录和性能统计（后台刷新任务使用）
+     * @param buffer 帧数据
+     */
+    void sendFrameRaw(const uint8_t *buffer);
+
+    /**
+     * @brief 比较影子缓冲区，只发送差异区间（display()的差分路径）
+     * @param buffer 待发送的帧数据
+     */
+    void displayDiff(const uint8_t *buffer);
+
+    /**
+     * @brief 同步影子缓冲区（已发送的数据写入影子缓冲区）
+     * @param page 页地址
+     * @param col 起始列
+     * @param len 字节数
+     */
+    inline void syncShadow(uint8_t page, uint8_t col, uint16_t len)
+    {
+        if (_shadowBuffer != nullptr)
+        {
+            memcpy(&_shadowBuffer[page * LCD_WIDTH + col], &frameBuffer[page * LCD_WIDTH + col], len);
+        }
+    }
+
+    /**
+     * @brief 记录一次刷新的耗时和类型
+     * @param startUs 刷新开始时的micros()
+     * @param full true:全屏刷新, false:局部刷新
+     */
+    void recordFlush(uint32_t startUs, bool full);
+
+    /**
+     * @brief 按代价模型估算传输耗时
+     * @param segments 段数（每段一次地址设置）
+     * @param bytes 数据字节数
+     * @return 估算耗时（纳秒）
+     */
+    inline uint32_t flushCost(uint16_t segments, uint32_t bytes) const
+    {
+        return segments * _segmentCostNs + bytes * _byteCostNs;
+    }
+
+    /**
+     * @brief 根据SPI时钟设置默认代价模型参数
+     */
+    void initFlushCost();
+
     /**
      * @brief 开始SPI事务
      */
@@ -355,14 +1188,67 @@ private:
     int8_t _sclk; ///< 时钟引脚（软件SPI时使用）
     int8_t _mosi; ///< 数据输入引脚（软件SPI时使用）
 
+    // 软件SPI寄存器直写（构造时根据引脚计算，避免每位调用digitalWrite）
+    volatile uint32_t *_sclkSetReg; ///< SCLK置位寄存器
+    volatile uint32_t *_sclkClrReg; ///< SCLK清零寄存器
+    volatile uint32_t *_mosiSetReg; ///< MOSI置位寄存器
+    volatile uint32_t *_mosiClrReg; ///< MOSI清零寄存器
+    uint32_t _sclkMask;             ///< SCLK位掩码
+    uint32_t _mosiMask;             ///< MOSI位掩码
+    bool _fastSoftSPI;              ///< 是否使用寄存器直写
+
     // 显示控制参数
     uint8_t _contrast;           ///< 当前对比度值
     bool _useHardwareSPI;        ///< 使用硬件SPI标志
-    uint8_t *frameBuffer;        ///< 帧缓冲区指针（128x64/8 = 1024字节）
+    uint8_t *frameBuffer;        ///< 帧缓冲区指针（128x64/8 = 1024字节；构造后始终非空，页模式下指向页缓冲区）
+    uint8_t *_ownBuffer;         ///< 绑定外部缓冲区期间保存的自有缓冲区（nullptr:未绑定）
+    uint8_t *_staticBuffer;      ///< 不在堆上的自有帧缓冲区（ST7567_LCDT，nullptr:堆分配）
     
     // 显示状态控制
     bool _displayEnabled;         ///< 显示使能标志
 
+    // 页模式（frameBuffer只含第_bufferPage页，绘图裁剪到[_clipY0, _clipY1]行）
+    bool _pageMode;               ///< 是否处于页模式
+    uint8_t _bufferPage;          ///< frameBuffer首字节对应的页
+    int16_t _clipY0;              ///< 可绘制的第一行
+    int16_t _clipY1;              ///< 可绘制的最后一行（包含）
+    uint8_t *_pageBuffers[2];     ///< 页缓冲区（第二个仅在使用传输引擎时分配）
+
+    // 脏区跟踪（每页记录被修改的列范围，_dirtyX0 > _dirtyX1 表示该页干净）
+    uint8_t _dirtyX0[PAGE_COUNT]; ///< 各页脏区起始列
+    uint8_t _dirtyX1[PAGE_COUNT]; ///< 各页脏区结束列（包含）
+
+    bool _initialized;            ///< begin()是否已完成
+    uint8_t _batchDepth;          ///< 批次嵌套深度（0:CS未使能）
+    int8_t _dcState;              ///< 当前DC电平（-1:未知）
+
+    // 异步刷新
+    ST7567_FlushEngine *_flushEngine;             ///< 传输引擎（nullptr:同步传输）
+    uint8_t *_asyncBuffer;                        ///< 异步发送中的帧快照
+    uint8_t _asyncCmds[PAGE_COUNT][4];            ///< 各页地址命令（传输期间保持有效，按4字节对齐）
+    // 常驻双缓冲
+    uint8_t *_frontBuffer;                        ///< 前台缓冲区（已显示/发送中，nullptr:未启用）
+    SwapMode _swapMode;                           ///< swapBuffers(nullptr)的默认交换方式
+
+    ST7567_FlushCallback _flushCallback;          ///< 异步刷新完成回调
+    void *_flushCallbackContext;                  ///< 回调上下文
+
+    // 影子缓冲区（控制器显示RAM的镜像）
+    uint8_t *_shadowBuffer;       ///< 影子缓冲区指针（未启用时为nullptr）
+    bool _shadowValid;            ///< 影子缓冲区内容是否与控制器一致
+
+    // 刷新代价模型
+    uint32_t _segmentCostNs;      ///< 每段固定开销（纳秒）
+    uint32_t _byteCostNs;         ///< 每数据字节开销（纳秒）
+    bool _flushCostFixed;         ///< 参数由用户设置（begin()不再校准）
+    FlushStrategy _lastStrategy;  ///< 最近一次refreshRegion()的策略
+
+    // 运行时性能指标（窗口统计字段在getMetrics()中计算）
+    ST7567_Metrics _metrics;                  ///< 累计计数
+    uint32_t _flushSamples[METRICS_WINDOW];   ///< 最近的刷新耗时（环形）
+    uint8_t _flushSamplePos;                  ///< 下一个样本写入位置
+    uint8_t _flushSampleCount;                ///< 有效样本数
+
     // 性能统计
     uint32_t _lastStatTime;       ///< 上次统计时间
     uint16_t _frameCount;         ///< 帧计数器
@@ -0,0 +1,95 @@
+/**
+ * @file ST7567_LCDT.h
+ * @brief ST7567 静态帧缓冲区驱动模板（不使用堆）
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details ST7567_LCD默认在构造函数中从堆分配1KB帧缓冲区。ST7567_LCDT把帧缓冲区放在
+ * 编译期确定的位置，内存占用在链接时即可确定，并能在链接映射文件（.map）中核对：
+ * - ST7567_InlineStorage：缓冲区是对象的成员，全局对象整体位于.bss（默认）
+ * - ST7567_StaticStorage<buf>：使用调用者定义的静态数组，缓冲区以数组自己的符号出现在.map中，
+ *   可以用section属性放到指定内存区域
+ *
+ * 尺寸是模板参数，编译期检查与驱动的LCD_WIDTH/LCD_HEIGHT一致（驱动内部的循环边界
+ * 本来就是编译期常量）；其余接口与ST7567_LCD完全相同，可以传给所有接收ST7567_LCD&的类。
+ *
+ * 使用示例：
+ * @code
+ * // 缓冲区内联在对象中
+ * ST7567_LCDT<128, 64> lcd(CS_PIN, RST_PIN, DC_PIN);
+ *
+ * // 使用调用者提供的静态数组
+ * alignas(4) uint8_t fb[ST7567_LCD::FRAME_SIZE];
+ * ST7567_LCDT<128, 64, ST7567_StaticStorage<fb>> lcd2(CS_PIN, RST_PIN, DC_PIN);
+ * @endcode
+ *
+ * @note 只有帧缓冲区是静态的：影子缓冲区、常驻双缓冲、异步快照和页模式的页缓冲区
+ * 仍在启用时从堆分配，完全不使用堆时不要启用这些功能
+ */
+
+#ifndef __ST7567_LCDT_H
+#define __ST7567_LCDT_H
+
+#include "ST7567_LCD.h"
+
+/**
+ * @brief 内联存储：缓冲区是驱动对象的成员
+ */
+template <uint16_t W, uint16_t H>
+class ST7567_InlineStorage
+{
+protected:
+    uint8_t *storage() { return _storage; }
+
+private:
+    alignas(4) uint8_t _storage[W * H / 8]; ///< 帧缓冲区（32位对齐，页内核按字访问）
+};
+
+/**
+ * @brief 外部静态存储：使用调用者定义的静态数组（大小在编译期检查）
+ * @tparam Buffer 静态数组（需4字节对齐）
+ */
+template <uint8_t (&Buffer)[ST7567_LCD::FRAME_SIZE]>
+class ST7567_StaticStorage
+{
+protected:
+    uint8_t *storage() { return Buffer; }
+};
+
+template <uint16_t W = ST7567_LCD::LCD_WIDTH, uint16_t H = ST7567_LCD::LCD_HEIGHT,
+          class Storage = ST7567_InlineStorage<W, H>>
+class ST7567_LCDT : private Storage, public ST7567_LCD
+{
+    static_assert(W == ST7567_LCD::LCD_WIDTH && H == ST7567_LCD::LCD_HEIGHT,
+                  "ST7567_LCDT only supports the 128x64 ST7567 panel");
+
+public:
+    /**
+     * @brief 硬件SPI构造函数
+     * @param cs   片选引脚
+     * @param rst  复位引脚
+     * @param dc   数据/命令选择引脚
+     * @param spi  SPI实例
+     * @param frequency SPI时钟频率
+     */
+    ST7567_LCDT(int8_t cs, int8_t rst, int8_t dc, SPIClass &spi = SPI, uint32_t frequency = 40000000)
+        : Storage(), ST7567_LCD(Storage::storage(), cs, rst, dc, spi, frequency)
+    {
+    }
+
+    /**
+     * @brief 软件SPI构造函数
+     * @param cs   片选引脚
+     * @param rst  复位引脚
+     * @param dc   数据/命令选择引脚
+     * @param sclk 时钟引脚
+     * @param mosi 数据输入引脚
+     */
+    ST7567_LCDT(int8_t cs, int8_t rst, int8_t dc, int8_t sclk, int8_t mosi)
+        : Storage(), ST7567_LCD(Storage::storage(), cs, rst, dc, sclk, mosi)
+    {
+    }
+};
+
+#endif // __ST7567_LCDT_H
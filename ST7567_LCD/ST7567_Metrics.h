@@ -0,0 +1,76 @@
+/**
+ * @file ST7567_Metrics.h
+ * @brief ST7567 运行时性能指标
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 驱动在传输和绘图路径上累计以下指标，可在运行时查询或输出为一行CSV：
+ * - 发送字节数、其中的命令字节数
+ * - CS/DC引脚翻转次数（每个边沿计一次）
+ * - 刷新耗时（最近METRICS_WINDOW次的最小/平均/最大/P99，微秒）
+ * - 全屏刷新与局部刷新次数及局部刷新占比
+ * - 各绘图原语的调用次数（包括Adafruit_GFX组合图形内部的调用）
+ *
+ * 编译时定义ST7567_METRICS=0可去掉所有计数语句（查询结果全为0）
+ */
+
+#ifndef __ST7567_METRICS_H
+#define __ST7567_METRICS_H
+
+#include <Arduino.h>
+
+#ifndef ST7567_METRICS
+#define ST7567_METRICS 1 ///< 1:启用性能计数, 0:编译时移除
+#endif
+
+#if ST7567_METRICS
+#define ST7567_METRIC(expr) \
+    do                      \
+    {                       \
+        expr;               \
+    } while (0)
+#else
+#define ST7567_METRIC(expr) \
+    do                      \
+    {                       \
+    } while (0)
+#endif
+
+/**
+ * @brief 计数的绘图原语
+ */
+enum ST7567_Primitive
+{
+    ST7567_PRIM_PIXEL,     ///< drawPixel
+    ST7567_PRIM_HLINE,     ///< drawFastHLine
+    ST7567_PRIM_VLINE,     ///< drawFastVLine
+    ST7567_PRIM_FILL_RECT, ///< fillRect
+    ST7567_PRIM_CHAR,      ///< drawChar
+    ST7567_PRIM_BITMAP,    ///< drawBitmap/drawXBitmap/drawCanvas
+    ST7567_PRIM_LINE,      ///< drawLine
+    ST7567_PRIM_SHAPE,     ///< drawCircle/fillCircle/fillTriangle/fillRoundRect
+    ST7567_PRIM_COUNT
+};
+
+/**
+ * @brief 性能指标快照
+ */
+struct ST7567_Metrics
+{
+    uint32_t bytesSent;      ///< 发送的总字节数（命令+数据）
+    uint32_t commandBytes;   ///< 其中的命令字节数
+    uint32_t csToggles;      ///< CS翻转次数
+    uint32_t dcToggles;      ///< DC翻转次数
+    uint32_t fullFlushes;    ///< 全屏刷新次数
+    uint32_t partialFlushes; ///< 局部/增量/差分刷新次数
+    uint8_t partialPercent;  ///< 局部刷新占全部刷新的百分比
+    uint16_t flushSamples;   ///< 统计窗口内的刷新样本数
+    uint32_t flushMinUs;     ///< 窗口内最短刷新时间
+    uint32_t flushAvgUs;     ///< 窗口内平均刷新时间
+    uint32_t flushMaxUs;     ///< 窗口内最长刷新时间
+    uint32_t flushP99Us;     ///< 窗口内P99刷新时间
+    uint32_t drawCalls[ST7567_PRIM_COUNT]; ///< 各绘图原语调用次数
+};
+
+#endif // __ST7567_METRICS_H
@@ -0,0 +1,146 @@
+/**
+ * @file ST7567_PageKernels.h
+ * @brief ST7567 页格式缓冲区绘图内核（驱动帧缓冲区与离屏图层共用）
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 页格式：每页8行，一个字节表示一列的8个像素（bit0在上），每页128字节连续存放。
+ * 内核只处理已裁剪的坐标，不做边界检查：
+ * - st7567_applyMaskByte()：对一个字节设置/清除/反转掩码位
+ * - st7567_applyMaskSpan()：对一页内连续字节应用同一掩码（32位字批量处理）
+ * - st7567_fillPages()：跨页矩形填充（首末页部分掩码，中间整页memset）
+ */
+
+#ifndef __ST7567_PAGE_KERNELS_H
+#define __ST7567_PAGE_KERNELS_H
+
+#include <Arduino.h>
+
+#ifndef ST7567_BLACK
+#define ST7567_BLACK 0   ///< 清除像素
+#define ST7567_WHITE 1   ///< 点亮像素
+#define ST7567_INVERSE 2 ///< 反转像素
+#endif
+
+/**
+ * @brief 允许别名访问的32位字类型（以字为单位读写字节缓冲区）
+ */
+typedef uint32_t __attribute__((__may_alias__)) st7567_word_t;
+
+/**
+ * @brief 行号所在的页号，向下取整（行号可以为负，-1在第-1页）
+ * @param y 行号
+ * @return 页号
+ */
+static inline int16_t st7567_floorPage(int16_t y)
+{
+    return (y >= 0) ? (y >> 3) : -((7 - y) >> 3);
+}
+
+/**
+ * @brief 对一个字节应用颜色掩码
+ * @param dst 目标字节
+ * @param mask 位掩码
+ * @param color ST7567_BLACK:清除, ST7567_INVERSE:反转, 其他:设置
+ */
+static inline void st7567_applyMaskByte(uint8_t &dst, uint8_t mask, uint16_t color)
+{
+    if (color == ST7567_INVERSE)
+        dst ^= mask;
+    else if (color)
+        dst |= mask;
+    else
+        dst &= ~mask;
+}
+
+/**
+ * @brief 对一页内连续w个字节应用同一颜色掩码
+ * @param dst 起始字节
+ * @param w 字节数
+ * @param mask 位掩码
+ * @param color 颜色
+ *
+ * 先逐字节处理到4字节对齐，中间按32位字处理（掩码复制到4个字节），最后处理剩余字节
+ */
+static inline void st7567_applyMaskSpan(uint8_t *dst, int16_t w, uint8_t mask, uint16_t color)
+{
+    // 非对齐的开头字节
+    while (w > 0 && ((uintptr_t)dst & 3))
+    {
+        st7567_applyMaskByte(*dst++, mask, color);
+        w--;
+    }
+
+    // 对齐的32位字
+    st7567_word_t *word = (st7567_word_t *)dst;
+    uint32_t mask32 = mask * 0x01010101UL;
+    int16_t words = w >> 2;
+    if (color == ST7567_INVERSE)
+    {
+        for (int16_t i = 0; i < words; i++)
+            word[i] ^= mask32;
+    }
+    else if (color)
+    {
+        for (int16_t i = 0; i < words; i++)
+            word[i] |= mask32;
+    }
+    else
+    {
+        for (int16_t i = 0; i < words; i++)
+            word[i] &= ~mask32;
+    }
+
+    // 剩余字节
+    dst += words << 2;
+    w &= 3;
+    while (w-- > 0)
+    {
+        st7567_applyMaskByte(*dst++, mask, color);
+    }
+}
+
+/**
+ * @brief 跨页矩形填充
+ * @param row 首页中矩形左上角所在字节
+ * @param stride 页间距（字节，通常为128）
+ * @param w 矩形宽度（字节数）
+ * @param pages 涉及的页数（>=1）
+ * @param firstMask 首页行掩码
+ * @param lastMask 末页行掩码
+ * @param color 颜色
+ *
+ * 首末页的部分掩码每个字节只访问一次；中间完整页设置/清除用memset，反转按32位字异或
+ */
+static inline void st7567_fillPages(uint8_t *row, uint16_t stride, int16_t w, uint8_t pages,
+                                    uint8_t firstMask, uint8_t lastMask, uint16_t color)
+{
+    if (pages == 1)
+    {
+        st7567_applyMaskSpan(row, w, firstMask & lastMask, color);
+        return;
+    }
+
+    // 首页部分行
+    st7567_applyMaskSpan(row, w, firstMask, color);
+
+    // 中间完整页
+    for (uint8_t i = 1; i < pages - 1; i++)
+    {
+        row += stride;
+        if (color == ST7567_INVERSE)
+        {
+            st7567_applyMaskSpan(row, w, 0xFF, color);
+        }
+        else
+        {
+            memset(row, color ? 0xFF : 0x00, w);
+        }
+    }
+
+    // 末页部分行
+    st7567_applyMaskSpan(row + stride, w, lastMask, color);
+}
+
+#endif // __ST7567_PAGE_KERNELS_H
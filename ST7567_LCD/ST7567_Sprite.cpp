@@ -0,0 +1,396 @@
+/**
+ * @file ST7567_Sprite.cpp
+ * @brief ST7567 精灵引擎实现
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#include "ST7567_Sprite.h"
+#include "ST7567_PageKernels.h"
+
+/**
+ * @brief 构造函数
+ * @param lcd 显示屏
+ */
+ST7567_SpriteEngine::ST7567_SpriteEngine(ST7567_LCD &lcd)
+    : _lcd(lcd), _orderCount(0), _rectCount(0)
+{
+    for (uint8_t i = 0; i < MAX_SPRITES; i++)
+    {
+        _sprites[i].used = false;
+        _sprites[i].save = nullptr;
+    }
+}
+
+/**
+ * @brief 析构函数
+ */
+ST7567_SpriteEngine::~ST7567_SpriteEngine()
+{
+    for (uint8_t i = 0; i < MAX_SPRITES; i++)
+    {
+        if (_sprites[i].save != nullptr)
+        {
+            delete[] _sprites[i].save;
+            _sprites[i].save = nullptr;
+        }
+    }
+}
+
+/**
+ * @brief 添加精灵
+ * @return 精灵编号，失败返回-1
+ */
+int8_t ST7567_SpriteEngine::addSprite(const uint8_t *bitmap, const uint8_t *mask, uint8_t w, uint8_t h,
+                                      int16_t x, int16_t y, int8_t z)
+{
+    if (bitmap == nullptr || w == 0 || h == 0 || w > ST7567_LCD::LCD_WIDTH || h > ST7567_LCD::LCD_HEIGHT)
+        return -1;
+
+    for (uint8_t i = 0; i < MAX_SPRITES; i++)
+    {
+        Sprite &s = _sprites[i];
+        if (s.used)
+            continue;
+
+        // 移位后最多多跨一页
+        s.save = new uint8_t[w * ((h + 7) / 8 + 1)];
+
+        s.bitmap = bitmap;
+        s.mask = mask;
+        s.x = x;
+        s.y = y;
+        s.w = w;
+        s.h = h;
+        s.z = z;
+        s.used = true;
+        s.visible = true;
+        s.removing = false;
+        s.changed = true;
+        s.saved = false;
+        s.onScreen = false;
+        return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief 移除精灵
+ */
+void ST7567_SpriteEngine::removeSprite(int8_t id)
+{
+    if (id < 0 || id >= MAX_SPRITES || !_sprites[id].used)
+        return;
+    _sprites[id].removing = true;
+    _sprites[id].changed = true;
+}
+
+/**
+ * @brief 移动精灵
+ */
+void ST7567_SpriteEngine::moveTo(int8_t id, int16_t x, int16_t y)
+{
+    if (id < 0 || id >= MAX_SPRITES || !_sprites[id].used)
+        return;
+    Sprite &s = _sprites[id];
+    if (s.x != x || s.y != y)
+    {
+        s.x = x;
+        s.y = y;
+        s.changed = true;
+    }
+}
+
+/**
+ * @brief 更换位图
+ */
+void ST7567_SpriteEngine::setBitmap(int8_t id, const uint8_t *bitmap, const uint8_t *mask)
+{
+    if (id < 0 || id >= MAX_SPRITES || !_sprites[id].used || bitmap == nullptr)
+        return;
+    _sprites[id].bitmap = bitmap;
+    _sprites[id].mask = mask;
+    _sprites[id].changed = true;
+}
+
+/**
+ * @brief 显示/隐藏精灵
+ */
+void ST7567_SpriteEngine::setVisible(int8_t id, bool visible)
+{
+    if (id < 0 || id >= MAX_SPRITES || !_sprites[id].used || _sprites[id].visible == visible)
+        return;
+    _sprites[id].visible = visible;
+    _sprites[id].changed = true;
+}
+
+/**
+ * @brief 修改z序
+ */
+void ST7567_SpriteEngine::setZ(int8_t id, int8_t z)
+{
+    if (id < 0 || id >= MAX_SPRITES || !_sprites[id].used || _sprites[id].z == z)
+        return;
+    _sprites[id].z = z;
+    _sprites[id].changed = true;
+}
+
+/**
+ * @brief 计算精灵覆盖的页对齐区域（已裁剪到屏幕）
+ * @return false:完全在屏幕外
+ */
+bool ST7567_SpriteEngine::coverage(const Sprite &s, int16_t &x0, uint8_t &w, uint8_t &page0, uint8_t &pages)
+{
+    int16_t left = max(s.x, (int16_t)0);
+    int16_t right = min((int16_t)(s.x + s.w - 1), (int16_t)(ST7567_LCD::LCD_WIDTH - 1));
+    int16_t top = st7567_floorPage(s.y);
+    int16_t bottom = st7567_floorPage(s.y + s.h - 1);
+    if (top < 0)
+        top = 0;
+    if (bottom >= ST7567_LCD::PAGE_COUNT)
+        bottom = ST7567_LCD::PAGE_COUNT - 1;
+    if (left > right || top > bottom)
+        return false;
+
+    x0 = left;
+    w = right - left + 1;
+    page0 = top;
+    pages = bottom - top + 1;
+    return true;
+}
+
+/**
+ * @brief 保存精灵当前位置下的背景
+ */
+void ST7567_SpriteEngine::saveBackground(Sprite &s)
+{
+    s.saved = coverage(s, s.saveX, s.saveW, s.savePage, s.savePages);
+    if (!s.saved)
+        return;
+
+    const uint8_t *fb = _lcd.getFrameBuffer();
+    for (uint8_t p = 0; p < s.savePages; p++)
+    {
+        memcpy(&s.save[p * s.saveW], &fb[(s.savePage + p) * ST7567_LCD::LCD_WIDTH + s.saveX], s.saveW);
+    }
+}
+
+/**
+ * @brief 把保存的背景写回帧缓冲区
+ */
+void ST7567_SpriteEngine::restoreBackground(Sprite &s)
+{
+    if (!s.saved)
+        return;
+
+    uint8_t *fb = _lcd.getFrameBuffer();
+    for (uint8_t p = 0; p < s.savePages; p++)
+    {
+        memcpy(&fb[(s.savePage + p) * ST7567_LCD::LCD_WIDTH + s.saveX], &s.save[p * s.saveW], s.saveW);
+    }
+    s.saved = false;
+}
+
+/**
+ * @brief 按上次绘制的逆序恢复背景（重叠精灵保存的是下层精灵画过的内容）
+ */
+void ST7567_SpriteEngine::restoreAll()
+{
+    while (_orderCount > 0)
+    {
+        restoreBackground(_sprites[_order[--_orderCount]]);
+    }
+}
+
+/**
+ * @brief 恢复所有精灵下的背景
+ */
+void ST7567_SpriteEngine::erase()
+{
+    if (_lcd.isPageMode())
+        return;
+
+    restoreAll();
+    for (uint8_t i = 0; i < MAX_SPRITES; i++)
+    {
+        if (_sprites[i].used)
+            _sprites[i].changed = true;
+    }
+}
+
+/**
+ * @brief 页对齐移位绘制
+ *
+ * 精灵第p页的一列字节左移shift位后成为16位：低字节写入目标页，高字节写入下一页。
+ * 目标 = (目标 & ~掩码) | (位图 & 掩码)，每列每页只读写两个字节
+ */
+void ST7567_SpriteEngine::drawSprite(const Sprite &s)
+{
+    uint8_t *fb = _lcd.getFrameBuffer();
+    int16_t basePage = st7567_floorPage(s.y);
+    uint8_t shift = s.y - basePage * 8;
+    uint8_t spritePages = (s.h + 7) / 8;
+    int16_t c0 = max((int16_t)0, (int16_t)-s.x);
+    int16_t c1 = min((int16_t)s.w, (int16_t)(ST7567_LCD::LCD_WIDTH - s.x));
+
+    for (uint8_t p = 0; p < spritePages; p++)
+    {
+        int16_t lo = basePage + p;
+        int16_t hi = lo + 1;
+        bool drawLo = lo >= 0 && lo < ST7567_LCD::PAGE_COUNT;
+        bool drawHi = shift != 0 && hi >= 0 && hi < ST7567_LCD::PAGE_COUNT;
+        if (!drawLo && !drawHi)
+            continue;
+
+        // 最后一页只有h % 8行有效
+        uint8_t rowMask = (p == spritePages - 1 && (s.h & 7)) ? (0xFF >> (8 - (s.h & 7))) : 0xFF;
+        const uint8_t *src = &s.bitmap[p * s.w];
+        const uint8_t *msk = s.mask != nullptr ? &s.mask[p * s.w] : nullptr;
+        uint8_t *dstLo = drawLo ? &fb[lo * ST7567_LCD::LCD_WIDTH] : nullptr;
+        uint8_t *dstHi = drawHi ? &fb[hi * ST7567_LCD::LCD_WIDTH] : nullptr;
+
+        for (int16_t c = c0; c < c1; c++)
+        {
+            int16_t x = s.x + c;
+            uint8_t m = msk != nullptr ? (msk[c] & rowMask) : rowMask;
+            uint16_t m16 = (uint16_t)m << shift;
+            uint16_t v16 = (uint16_t)(src[c] & m) << shift;
+            if (drawLo)
+                dstLo[x] = (dstLo[x] & ~(uint8_t)m16) | (uint8_t)v16;
+            if (drawHi)
+                dstHi[x] = (dstHi[x] & ~(uint8_t)(m16 >> 8)) | (uint8_t)(v16 >> 8);
+        }
+    }
+}
+
+/**
+ * @brief 添加脏矩形，与已有矩形合并（合并后面积不大于两者之和时）
+ */
+void ST7567_SpriteEngine::addRect(const ST7567_Rect &r)
+{
+    ST7567_Rect cur = r;
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (uint8_t i = 0; i < _rectCount; i++)
+        {
+            const ST7567_Rect &o = _rects[i];
+            int16_t x0 = min(cur.x, o.x);
+            int16_t y0 = min(cur.y, o.y);
+            int16_t x1 = max(cur.x + cur.w, o.x + o.w);
+            int16_t y1 = max(cur.y + cur.h, o.y + o.h);
+            if ((int32_t)(x1 - x0) * (y1 - y0) <= (int32_t)cur.w * cur.h + (int32_t)o.w * o.h)
+            {
+                cur.x = x0;
+                cur.y = y0;
+                cur.w = x1 - x0;
+                cur.h = y1 - y0;
+                _rects[i] = _rects[--_rectCount];
+                merged = true;
+                break;
+            }
+        }
+    }
+    if (_rectCount < MAX_RECTS)
+        _rects[_rectCount++] = cur;
+}
+
+/**
+ * @brief 更新一帧
+ * @param flush true:立即刷新, false:只登记脏区
+ * @return 脏矩形数
+ *
+ * 每个有变化的精灵贡献旧位置和新位置两个矩形（相交或相邻时合并为并集），
+ * 未变化的精灵重新绘制但不产生刷新；刷新使用refreshRegion()，按代价模型决定每个矩形的发送方式
+ */
+uint8_t ST7567_SpriteEngine::update(bool flush)
+{
+    _rectCount = 0;
+    if (_lcd.isPageMode())
+        return 0;
+
+    restoreAll();
+
+    // 绘制顺序：z升序，z相同按编号（插入排序，最多8个）
+    for (uint8_t i = 0; i < MAX_SPRITES; i++)
+    {
+        const Sprite &s = _sprites[i];
+        if (!s.used || !s.visible || s.removing)
+            continue;
+        uint8_t k = _orderCount++;
+        while (k > 0 && _sprites[_order[k - 1]].z > s.z)
+        {
+            _order[k] = _order[k - 1];
+            k--;
+        }
+        _order[k] = i;
+    }
+
+    for (uint8_t k = 0; k < _orderCount; k++)
+    {
+        Sprite &s = _sprites[_order[k]];
+        saveBackground(s);
+        if (s.saved)
+            drawSprite(s);
+    }
+
+    // 收集新旧位置矩形
+    for (uint8_t i = 0; i < MAX_SPRITES; i++)
+    {
+        Sprite &s = _sprites[i];
+        if (!s.used || !s.changed)
+            continue;
+
+        if (s.onScreen)
+            addRect(s.old);
+        if (s.saved)
+        {
+            ST7567_Rect r = {s.saveX, (int16_t)(s.savePage * 8), s.saveW, (int16_t)(s.savePages * 8)};
+            addRect(r);
+            s.old = r;
+        }
+        s.onScreen = s.saved;
+        s.changed = false;
+
+        if (s.removing)
+        {
+            delete[] s.save;
+            s.save = nullptr;
+            s.used = false;
+        }
+    }
+
+    for (uint8_t i = 0; i < _rectCount; i++)
+    {
+        const ST7567_Rect &r = _rects[i];
+        if (flush)
+            _lcd.refreshRegion(r.x, r.y, r.w, r.h);
+        else
+            _lcd.markDirtyRegion(r.x, r.y, r.w, r.h);
+    }
+    return _rectCount;
+}
+
+/**
+ * @brief 行优先位图转页格式
+ */
+void ST7567_SpriteEngine::packBitmap(const uint8_t *src, uint8_t w, uint8_t h, uint8_t *dst)
+{
+    uint8_t stride = (w + 7) / 8;
+    uint8_t pages = (h + 7) / 8;
+    memset(dst, 0x00, pages * w);
+
+    for (uint8_t y = 0; y < h; y++)
+    {
+        const uint8_t *row = &src[y * stride];
+        uint8_t *out = &dst[(y / 8) * w];
+        uint8_t bit = 1 << (y & 7);
+        for (uint8_t x = 0; x < w; x++)
+        {
+            if (row[x >> 3] & (0x80 >> (x & 7)))
+                out[x] |= bit;
+        }
+    }
+}
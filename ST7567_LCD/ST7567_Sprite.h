@@ -0,0 +1,188 @@
+/**
+ * @file ST7567_Sprite.h
+ * @brief ST7567 精灵引擎（背景保存/恢复 + 脏矩形刷新）
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 面向"静态场景 + 少量移动物体"的场景（如testPattern(1)的弹跳矩形）：
+ * - 绘制精灵前保存其覆盖区域的背景，下一帧恢复，场景不需要重绘
+ * - 精灵位图为页格式（每字节一列8个像素，bit0在上），按y&7做16位移位后跨两页写入
+ * - 支持掩码（页格式，点亮的像素表示不透明）和z序（z小的先画，在下面）
+ * - 每个精灵输出新旧位置的并集矩形，只刷新这些区域
+ *
+ * 移动8个16x16精灵每帧约发送几百字节，而不是整屏重绘加整屏刷新。
+ *
+ * 典型用法：
+ * @code
+ * ST7567_SpriteEngine sprites(lcd);
+ * int8_t ball = sprites.addSprite(ballBitmap, ballMask, 16, 16, 0, 0);
+ * // 每帧
+ * sprites.moveTo(ball, x, y);
+ * sprites.update(); // 恢复背景、绘制、刷新脏矩形
+ * @endcode
+ *
+ * @note 修改精灵下面的场景前需调用erase()，否则保存的背景会覆盖新的场景内容；
+ * 双缓冲时只能配合SWAP_COPY使用；分页渲染模式下不可用
+ */
+
+#ifndef __ST7567_SPRITE_H
+#define __ST7567_SPRITE_H
+
+#include "ST7567_LCD.h"
+
+/**
+ * @brief 屏幕矩形（像素坐标）
+ */
+struct ST7567_Rect
+{
+    int16_t x; ///< 左上角X
+    int16_t y; ///< 左上角Y
+    int16_t w; ///< 宽度
+    int16_t h; ///< 高度
+};
+
+class ST7567_SpriteEngine
+{
+public:
+    static const uint8_t MAX_SPRITES = 8;                ///< 最大精灵数
+    static const uint8_t MAX_RECTS = MAX_SPRITES * 2;    ///< 每帧最多脏矩形数
+
+    /**
+     * @brief 构造函数
+     * @param lcd 显示屏（精灵绘制到其帧缓冲区）
+     */
+    ST7567_SpriteEngine(ST7567_LCD &lcd);
+
+    /**
+     * @brief 析构函数 - 释放背景保存缓冲区
+     */
+    ~ST7567_SpriteEngine();
+
+    /**
+     * @brief 添加精灵
+     * @param bitmap 页格式位图（((h + 7) / 8) * w字节）
+     * @param mask 页格式掩码（格式同bitmap），nullptr表示整个矩形不透明
+     * @param w 宽度（像素，1~128）
+     * @param h 高度（像素，1~64）
+     * @param x 初始X坐标
+     * @param y 初始Y坐标
+     * @param z z序（大的在上面）
+     * @return 精灵编号，精灵已满时返回-1
+     */
+    int8_t addSprite(const uint8_t *bitmap, const uint8_t *mask, uint8_t w, uint8_t h,
+                     int16_t x, int16_t y, int8_t z = 0);
+
+    /**
+     * @brief 移除精灵（下次update()时恢复其背景）
+     * @param id 精灵编号
+     */
+    void removeSprite(int8_t id);
+
+    /**
+     * @brief 移动精灵
+     * @param id 精灵编号
+     * @param x 新X坐标（可部分或完全移出屏幕）
+     * @param y 新Y坐标
+     */
+    void moveTo(int8_t id, int16_t x, int16_t y);
+
+    /**
+     * @brief 更换位图（尺寸不变，用于动画帧）
+     * @param id 精灵编号
+     * @param bitmap 页格式位图
+     * @param mask 页格式掩码
+     */
+    void setBitmap(int8_t id, const uint8_t *bitmap, const uint8_t *mask = nullptr);
+
+    /**
+     * @brief 显示/隐藏精灵
+     */
+    void setVisible(int8_t id, bool visible);
+
+    /**
+     * @brief 修改z序
+     */
+    void setZ(int8_t id, int8_t z);
+
+    /**
+     * @brief 恢复所有精灵下的背景（帧缓冲区中不再有精灵）
+     *
+     * 修改场景前调用，之后update()会在新场景上重新保存背景
+     */
+    void erase();
+
+    /**
+     * @brief 更新一帧
+     * @param flush true:立即刷新脏矩形, false:只登记为脏区（由调用者displayDirty()）
+     * @return 本帧脏矩形数
+     *
+     * 流程：恢复背景（按绘制的逆序） → 按z序保存背景并绘制 → 合并新旧位置矩形 → 刷新
+     */
+    uint8_t update(bool flush = true);
+
+    /**
+     * @brief 获取上次update()的脏矩形
+     * @param index 矩形序号（0 ~ getDirtyRectCount()-1）
+     */
+    const ST7567_Rect &getDirtyRect(uint8_t index) const { return _rects[index]; }
+
+    /**
+     * @brief 获取上次update()的脏矩形数
+     */
+    uint8_t getDirtyRectCount() const { return _rectCount; }
+
+    /**
+     * @brief 将行优先位图（Adafruit drawBitmap格式，MSB在左）转换为页格式
+     * @param src 行优先位图（每行(w + 7) / 8字节）
+     * @param w 宽度
+     * @param h 高度
+     * @param dst 输出缓冲区（((h + 7) / 8) * w字节）
+     */
+    static void packBitmap(const uint8_t *src, uint8_t w, uint8_t h, uint8_t *dst);
+
+private:
+    struct Sprite
+    {
+        const uint8_t *bitmap; ///< 页格式位图
+        const uint8_t *mask;   ///< 页格式掩码
+        uint8_t *save;         ///< 背景保存区（w * (pages + 1)字节）
+        int16_t x;             ///< X坐标
+        int16_t y;             ///< Y坐标
+        uint8_t w;             ///< 宽度
+        uint8_t h;             ///< 高度
+        int8_t z;              ///< z序
+        bool used;             ///< 槽位已占用
+        bool visible;          ///< 是否显示
+        bool removing;         ///< 等待移除
+        bool changed;          ///< 位置/位图/可见性/z序有变化，需要刷新
+        bool saved;            ///< save中有有效背景（精灵在帧缓冲区中）
+        bool onScreen;         ///< 上次刷新后精灵在屏幕上（old有效）
+        int16_t saveX;         ///< 保存区域起始列
+        uint8_t saveW;         ///< 保存区域宽度
+        uint8_t savePage;      ///< 保存区域起始页
+        uint8_t savePages;     ///< 保存区域页数
+        ST7567_Rect old;       ///< 上次绘制覆盖的矩形（页对齐）
+    };
+
+    /**
+     * @brief 计算精灵在当前位置覆盖的页对齐区域
+     * @return false:完全在屏幕外
+     */
+    static bool coverage(const Sprite &s, int16_t &x0, uint8_t &w, uint8_t &page0, uint8_t &pages);
+
+    void restoreAll();
+    void saveBackground(Sprite &s);
+    void restoreBackground(Sprite &s);
+    void drawSprite(const Sprite &s);
+    void addRect(const ST7567_Rect &r);
+
+    ST7567_LCD &_lcd;                 ///< 目标显示屏
+    Sprite _sprites[MAX_SPRITES];     ///< 精灵槽位
+    uint8_t _order[MAX_SPRITES];      ///< 上次绘制顺序
+    uint8_t _orderCount;              ///< 上次绘制的精灵数
+    ST7567_Rect _rects[MAX_RECTS];    ///< 本帧脏矩形
+    uint8_t _rectCount;               ///< 本帧脏矩形数
+};
+
+#endif // __ST7567_SPRITE_H
@@ -0,0 +1,165 @@
+/**
+ * @file ST7567_Surface.cpp
+ * @brief ST7567 页格式离屏绘图表面实现
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#include "ST7567_Surface.h"
+#include "ST7567_PageKernels.h"
+
+/**
+ * @brief 构造函数
+ * @param buffer 外部缓冲区（nullptr时自动分配并清零）
+ */
+ST7567_Surface::ST7567_Surface(uint8_t *buffer)
+    : Adafruit_GFX(ST7567_LCD::LCD_WIDTH, ST7567_LCD::LCD_HEIGHT), _buffer(buffer),
+      _ownsBuffer(buffer == nullptr), _dirtyPages(0xFF)
+{
+    if (_ownsBuffer)
+    {
+        _buffer = new uint8_t[ST7567_LCD::FRAME_SIZE]();
+    }
+}
+
+/**
+ * @brief 析构函数
+ */
+ST7567_Surface::~ST7567_Surface()
+{
+    if (_ownsBuffer && _buffer != nullptr)
+    {
+        delete[] _buffer;
+        _buffer = nullptr;
+    }
+}
+
+/**
+ * @brief 绘制像素点
+ * @param x X坐标
+ * @param y Y坐标
+ * @param color 颜色（ST7567_BLACK/ST7567_WHITE/ST7567_INVERSE）
+ */
+void ST7567_Surface::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (rotation != 0)
+        ST7567_LCD::rotatePoint(rotation, x, y);
+
+    if ((x < 0) || (x >= ST7567_LCD::LCD_WIDTH) || (y < 0) || (y >= ST7567_LCD::LCD_HEIGHT))
+        return;
+
+    uint8_t page = y / 8;
+    markPages(page, page);
+    st7567_applyMaskByte(_buffer[page * ST7567_LCD::LCD_WIDTH + x], 1 << (y & 7), color);
+}
+
+/**
+ * @brief 绘制水平线（同一页内按32位字批量处理）
+ *
+ * 旋转时按1行高的矩形处理（旋转1/3时是物理竖直线）
+ */
+void ST7567_Surface::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    if (rotation != 0)
+    {
+        fillRect(x, y, w, 1, color);
+        return;
+    }
+
+    if (y < 0 || y >= ST7567_LCD::LCD_HEIGHT || w <= 0)
+        return;
+    if (x < 0)
+    {
+        w += x;
+        x = 0;
+    }
+    if (x + w > ST7567_LCD::LCD_WIDTH)
+    {
+        w = ST7567_LCD::LCD_WIDTH - x;
+    }
+    if (w <= 0)
+        return;
+
+    uint8_t page = y / 8;
+    markPages(page, page);
+    st7567_applyMaskSpan(&_buffer[page * ST7567_LCD::LCD_WIDTH + x], w, 1 << (y & 7), color);
+}
+
+/**
+ * @brief 绘制垂直线（按页处理，每页一个字节）
+ */
+void ST7567_Surface::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    fillRect(x, y, 1, h, color);
+}
+
+/**
+ * @brief 填充矩形（页式填充内核，旋转在入口映射为物理矩形）
+ */
+void ST7567_Surface::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (w <= 0 || h <= 0)
+        return;
+    if (rotation != 0)
+        ST7567_LCD::rotateRect(rotation, x, y, w, h);
+    if (x < 0)
+    {
+        w += x;
+        x = 0;
+    }
+    if (y < 0)
+    {
+        h += y;
+        y = 0;
+    }
+    if (x + w > ST7567_LCD::LCD_WIDTH)
+    {
+        w = ST7567_LCD::LCD_WIDTH - x;
+    }
+    if (y + h > ST7567_LCD::LCD_HEIGHT)
+    {
+        h = ST7567_LCD::LCD_HEIGHT - y;
+    }
+    if (w <= 0 || h <= 0)
+        return;
+
+    uint8_t startPage = y / 8;
+    uint8_t endPage = (y + h - 1) / 8;
+    markPages(startPage, endPage);
+    st7567_fillPages(&_buffer[startPage * ST7567_LCD::LCD_WIDTH + x], ST7567_LCD::LCD_WIDTH, w,
+                     endPage - startPage + 1, 0xFF << (y & 7), 0xFF >> (7 - ((y + h - 1) & 7)), color);
+}
+
+/**
+ * @brief 整个表面填充同一颜色
+ * @param color 颜色
+ */
+void ST7567_Surface::fillScreen(uint16_t color)
+{
+    if (color == ST7567_INVERSE)
+    {
+        st7567_applyMaskSpan(_buffer, ST7567_LCD::FRAME_SIZE, 0xFF, color);
+    }
+    else
+    {
+        memset(_buffer, color ? 0xFF : 0x00, ST7567_LCD::FRAME_SIZE);
+    }
+    _dirtyPages = 0xFF;
+}
+
+/**
+ * @brief 读取像素
+ * @param x X坐标
+ * @param y Y坐标
+ * @return true:像素点亮
+ */
+bool ST7567_Surface::getPixel(int16_t x, int16_t y) const
+{
+    if (rotation != 0)
+        ST7567_LCD::rotatePoint(rotation, x, y);
+
+    if ((x < 0) || (x >= ST7567_LCD::LCD_WIDTH) || (y < 0) || (y >= ST7567_LCD::LCD_HEIGHT))
+        return false;
+    return _buffer[(y / 8) * ST7567_LCD::LCD_WIDTH + x] & (1 << (y & 7));
+}
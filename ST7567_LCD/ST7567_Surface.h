@@ -0,0 +1,89 @@
+/**
+ * @file ST7567_Surface.h
+ * @brief ST7567 页格式离屏绘图表面
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 与ST7567_LCD帧缓冲区格式相同（128x64，8页 × 128字节，bit0在上）的离屏缓冲区，
+ * 继承Adafruit_GFX，可使用全部绘图函数：
+ * - drawPixel/drawFastHLine/drawFastVLine/fillRect/fillScreen使用与驱动相同的页格式内核
+ * - 按页记录修改（8位掩码），供图层合成器只重新合成被修改的页
+ * - 支持setRotation()：绘图函数和getPixel()按与驱动相同的映射转换为物理坐标，
+ *   缓冲区本身（getBuffer()、合成）始终是物理页格式
+ *
+ * @note 外部提供的缓冲区需至少1024字节且4字节对齐（合成内核按32位字访问）
+ */
+
+#ifndef __ST7567_SURFACE_H
+#define __ST7567_SURFACE_H
+
+#include "ST7567_LCD.h"
+
+class ST7567_Surface : public Adafruit_GFX
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param buffer 外部缓冲区（FRAME_SIZE字节，4字节对齐）；nullptr时自动分配
+     */
+    ST7567_Surface(uint8_t *buffer = nullptr);
+
+    /**
+     * @brief 析构函数 - 释放自动分配的缓冲区
+     */
+    ~ST7567_Surface();
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+
+    /**
+     * @brief 读取像素
+     * @param x X坐标（逻辑坐标，受setRotation()影响）
+     * @param y Y坐标
+     * @return true:像素点亮（越界返回false）
+     */
+    bool getPixel(int16_t x, int16_t y) const;
+
+    /**
+     * @brief 获取缓冲区指针
+     * @return 页格式缓冲区
+     */
+    uint8_t *getBuffer() { return _buffer; }
+    const uint8_t *getBuffer() const { return _buffer; }
+
+    /**
+     * @brief 获取被修改的页
+     * @return 页掩码（bit n对应第n页）
+     */
+    uint8_t getDirtyPages() const { return _dirtyPages; }
+
+    /**
+     * @brief 登记被修改的页（直接写缓冲区后使用）
+     * @param mask 页掩码
+     */
+    void markDirtyPages(uint8_t mask) { _dirtyPages |= mask; }
+
+    /**
+     * @brief 清除页修改记录
+     */
+    void clearDirty() { _dirtyPages = 0; }
+
+private:
+    /**
+     * @brief 记录page0到page1（包含）被修改
+     */
+    inline void markPages(uint8_t page0, uint8_t page1)
+    {
+        _dirtyPages |= (uint8_t)((0xFF << page0) & (0xFF >> (7 - page1)));
+    }
+
+    uint8_t *_buffer;     ///< 页格式缓冲区
+    bool _ownsBuffer;     ///< 缓冲区是否由本对象分配
+    uint8_t _dirtyPages;  ///< 被修改的页掩码
+};
+
+#endif // __ST7567_SURFACE_H
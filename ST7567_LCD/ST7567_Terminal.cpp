@@ -0,0 +1,211 @@
+/**
+ * @file ST7567_Terminal.cpp
+ * @brief ST7567 硬件滚动终端实现
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#include "ST7567_Terminal.h"
+
+/**
+ * @brief 构造函数
+ * @param lcd 显示屏驱动
+ */
+ST7567_Terminal::ST7567_Terminal(ST7567_LCD &lcd)
+    : _lcd(lcd), _top(0), _row(0), _col(0), _pendingNewline(false), _scrollPending(false), _autoFlush(false)
+{
+}
+
+/**
+ * @brief 进入终端模式
+ */
+void ST7567_Terminal::begin()
+{
+    if (_lcd.isPageMode())
+        return;
+
+    clear();
+}
+
+/**
+ * @brief 清屏并复位光标和滚动位置
+ *
+ * 起始行与清屏数据在同一批次中发送
+ */
+void ST7567_Terminal::clear()
+{
+    _top = 0;
+    _row = 0;
+    _col = 0;
+    _pendingNewline = false;
+    _scrollPending = false;
+
+    _lcd.clearDisplay();
+    _lcd.beginBatch();
+    const uint8_t cmd = 0x40; // 起始行0
+    _lcd.batchCommands(&cmd, 1);
+    _lcd.display();
+    _lcd.endBatch();
+}
+
+/**
+ * @brief 退出终端模式，恢复线性页序
+ *
+ * 帧缓冲区循环左移_top页（每次一页，使用128字节栈缓冲区），
+ * 然后起始行归零并刷新变化的部分
+ */
+void ST7567_Terminal::end()
+{
+    if (_lcd.isPageMode())
+        return;
+
+    flush();
+
+    uint8_t *fb = _lcd.getFrameBuffer();
+    uint8_t tmp[ST7567_LCD::LCD_WIDTH];
+    for (uint8_t i = 0; i < _top; i++)
+    {
+        memcpy(tmp, fb, ST7567_LCD::LCD_WIDTH);
+        memmove(fb, fb + ST7567_LCD::LCD_WIDTH, ST7567_LCD::FRAME_SIZE - ST7567_LCD::LCD_WIDTH);
+        memcpy(fb + ST7567_LCD::FRAME_SIZE - ST7567_LCD::LCD_WIDTH, tmp, ST7567_LCD::LCD_WIDTH);
+    }
+
+    _lcd.markAllDirty();
+    _lcd.beginBatch();
+    const uint8_t cmd = 0x40;
+    _lcd.batchCommands(&cmd, 1);
+    _lcd.display();
+    _lcd.endBatch();
+
+    _top = 0;
+    _row = 0;
+    _col = 0;
+    _pendingNewline = false;
+}
+
+/**
+ * @brief 输出一个字符
+ * @param c 字符
+ * @return 1；分页渲染模式下为0
+ *
+ * 处理流程：
+ * 1. 上一字符是'\n'时先换行（末行时滚动）
+ * 2. '\n'：发送当前行并挂起换行
+ * 3. 超出行宽时发送当前行并自动换行
+ * 4. 字形以白字黑底直接写入当前页（页对齐，即memcpy）
+ */
+size_t ST7567_Terminal::write(uint8_t c)
+{
+    if (_lcd.isPageMode())
+        return 0;
+
+    if (c == '\r')
+    {
+        _col = 0;
+        return 1;
+    }
+
+    if (_pendingNewline)
+    {
+        newLine();
+    }
+
+    if (c == '\n')
+    {
+        flushLine();
+        _pendingNewline = true;
+        return 1;
+    }
+
+    if (_col >= COLUMNS)
+    {
+        flushLine();
+        newLine();
+    }
+
+    // 与Adafruit_GFX::drawChar()相同的cp437兼容修正
+    if (!_lcd._cp437 && c >= 176)
+        c++;
+
+    _lcd.drawGlyph5x7(_col * CHAR_WIDTH, currentPage() * 8, c, ST7567_WHITE, ST7567_BLACK);
+    _col++;
+
+    if (_autoFlush)
+    {
+        flushLine();
+    }
+    return 1;
+}
+
+/**
+ * @brief 立即发送当前行
+ */
+void ST7567_Terminal::flush()
+{
+    flushLine();
+}
+
+/**
+ * @brief 移到下一行
+ *
+ * 未到末行时光标下移；已在末行时_top前进一页，原来的顶行成为新的底行，
+ * 只在帧缓冲区中清空该页并登记为脏，起始行命令随该行一起发送
+ */
+void ST7567_Terminal::newLine()
+{
+    if (_lcd.isPageMode())
+        return;
+
+    _pendingNewline = false;
+    _col = 0;
+
+    if (_row < ROWS - 1)
+    {
+        _row++;
+    }
+    else
+    {
+        _top = (_top + 1) % ROWS;
+        _scrollPending = true;
+    }
+
+    uint8_t page = currentPage();
+    memset(&_lcd.getFrameBuffer()[page * ST7567_LCD::LCD_WIDTH], 0x00, ST7567_LCD::LCD_WIDTH);
+    _lcd.markDirty(0, ST7567_LCD::LCD_WIDTH - 1, page, page);
+}
+
+/**
+ * @brief 发送当前页的脏列区间和待执行的滚动
+ *
+ * 页数据在前、起始行命令在后，滚入视野时该页已是新内容。
+ * 整行只拉低一次CS：3字节地址 + 最多128字节数据 + 1字节起始行
+ */
+void ST7567_Terminal::flushLine()
+{
+    if (_lcd.isPageMode())
+        return;
+
+    uint8_t page = currentPage();
+    bool dirty = _lcd._dirtyX0[page] <= _lcd._dirtyX1[page];
+    if (!dirty && !_scrollPending)
+        return;
+
+    _lcd.beginBatch();
+    if (dirty)
+    {
+        uint8_t x0 = _lcd._dirtyX0[page];
+        uint16_t len = _lcd._dirtyX1[page] - x0 + 1;
+        _lcd.writePage(page, x0, &_lcd.getFrameBuffer()[page * ST7567_LCD::LCD_WIDTH + x0], len);
+        _lcd.syncShadow(page, x0, len);
+        _lcd._dirtyX0[page] = 0xFF;
+        _lcd._dirtyX1[page] = 0x00;
+    }
+    if (_scrollPending)
+    {
+        const uint8_t cmd = 0x40 | (_top * 8); // 设置显示起始行
+        _lcd.batchCommands(&cmd, 1);
+        _scrollPending = false;
+    }
+    _lcd.endBatch();
+}
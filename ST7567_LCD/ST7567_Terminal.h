@@ -0,0 +1,123 @@
+/**
+ * @file ST7567_Terminal.h
+ * @brief ST7567 硬件滚动终端（日志/控制台模式）
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 把64行显示RAM当作8页的环形缓冲区使用：
+ * - 每行文本占一页（5x7字体，21列 × 8行）
+ * - 新行只写入即将滚入视野的那一页，通过设置显示起始行（0x40|line）完成滚动，
+ *   不移动帧缓冲区，也不重发整帧
+ * - 行缓冲：一行结束（'\n'）时在一次CS有效期内发送该页（3+128字节）和起始行命令（1字节），
+ *   每行约132字节，而整帧刷新为1048字节
+ *
+ * 环形映射：屏幕第r行文本 = 帧缓冲区/显示RAM第(_top + r) % 8页，起始行 = _top * 8
+ *
+ * 使用示例：
+ * @code
+ * ST7567_LCD lcd(CS_PIN, RST_PIN, DC_PIN);
+ * ST7567_Terminal term(lcd);
+ *
+ * void setup() {
+ *     lcd.begin();
+ *     term.begin();
+ * }
+ *
+ * void loop() {
+ *     term.printf("t=%lu\n", millis()); // 每行一次页传输
+ * }
+ * @endcode
+ *
+ * @note 终端模式期间帧缓冲区按显示RAM页存放（与屏幕行错位），不要混用其他绘图函数；
+ * 退出时调用end()恢复线性布局。仅支持旋转0，分页渲染模式下不可用（begin()/write()/end()不操作）。
+ */
+
+#ifndef __ST7567_TERMINAL_H
+#define __ST7567_TERMINAL_H
+
+#include "ST7567_LCD.h"
+
+class ST7567_Terminal : public Print
+{
+public:
+    static const uint8_t CHAR_WIDTH = 6;                                ///< 字符宽度（5列字形+1列间隔）
+    static const uint8_t COLUMNS = ST7567_LCD::LCD_WIDTH / CHAR_WIDTH;  ///< 每行字符数（21）
+    static const uint8_t ROWS = ST7567_LCD::PAGE_COUNT;                 ///< 文本行数（每页一行，共8行）
+
+    /**
+     * @brief 构造函数
+     * @param lcd 显示屏驱动（需已调用begin()）
+     */
+    ST7567_Terminal(ST7567_LCD &lcd);
+
+    /**
+     * @brief 进入终端模式：清屏、起始行归零、光标回到左上角
+     */
+    void begin();
+
+    /**
+     * @brief 退出终端模式：把环形页序恢复为线性布局，起始行归零
+     *
+     * 之后可继续使用ST7567_LCD的绘图函数和display()
+     */
+    void end();
+
+    /**
+     * @brief 清屏并复位光标和滚动位置
+     */
+    void clear();
+
+    /**
+     * @brief 输出一个字符
+     * @param c 字符（'\n'换行并发送当前行，'\r'回到行首）
+     * @return 1
+     *
+     * 超过COLUMNS列自动换行；行缓冲模式下字符只写入帧缓冲区
+     */
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    /**
+     * @brief 立即发送当前行（包括待执行的滚动）
+     */
+    void flush();
+
+    /**
+     * @brief 设置自动刷新
+     * @param enable true:每个字符立即发送（约9字节）, false:行缓冲（默认）
+     */
+    void setAutoFlush(bool enable) { _autoFlush = enable; }
+
+    /**
+     * @brief 获取屏幕第0行对应的显示RAM页
+     * @return 页号（0-7）
+     */
+    uint8_t getTopPage() const { return _top; }
+
+private:
+    /**
+     * @brief 移到下一行，最后一行时滚动（清空滚入视野的页）
+     */
+    void newLine();
+
+    /**
+     * @brief 发送当前页的脏列区间，并在同一批次中设置起始行
+     */
+    void flushLine();
+
+    /**
+     * @brief 光标所在行对应的显示RAM页
+     */
+    inline uint8_t currentPage() const { return (_top + _row) % ROWS; }
+
+    ST7567_LCD &_lcd;      ///< 显示屏驱动
+    uint8_t _top;          ///< 屏幕第0行对应的页
+    uint8_t _row;          ///< 光标所在屏幕行（0-7）
+    uint8_t _col;          ///< 光标所在列（0-COLUMNS）
+    bool _pendingNewline;  ///< 已收到'\n'，下一字符到来时再换行（末行不提前滚出空行）
+    bool _scrollPending;   ///< 起始行已变化但尚未发送
+    bool _autoFlush;       ///< 每个字符立即发送
+};
+
+#endif // __ST7567_TERMINAL_H
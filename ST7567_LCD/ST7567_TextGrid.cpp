@@ -0,0 +1,212 @@
+/**
+ * @file ST7567_TextGrid.cpp
+ * @brief ST7567 字符网格实现
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#include "ST7567_TextGrid.h"
+#include "ST7567_PageKernels.h"
+
+static const uint32_t ALL_COLUMNS = (1UL << ST7567_TextGrid::COLUMNS) - 1; ///< 一行全部单元
+
+/**
+ * @brief 构造函数
+ * @param lcd 显示屏驱动
+ */
+ST7567_TextGrid::ST7567_TextGrid(ST7567_LCD &lcd)
+    : _lcd(lcd), _cursorCol(0), _cursorRow(0), _attr(ATTR_NORMAL)
+{
+    memset(_chars, ' ', sizeof(_chars));
+    memset(_attrs, ATTR_NORMAL, sizeof(_attrs));
+    invalidate();
+}
+
+/**
+ * @brief 清空网格并标记全部单元
+ */
+void ST7567_TextGrid::begin()
+{
+    clear();
+    invalidate();
+    _cursorCol = 0;
+    _cursorRow = 0;
+    _attr = ATTR_NORMAL;
+}
+
+/**
+ * @brief 所有单元填充空格
+ */
+void ST7567_TextGrid::clear()
+{
+    for (uint8_t row = 0; row < ROWS; row++)
+    {
+        clearRow(row);
+    }
+}
+
+/**
+ * @brief 一行填充空格（已经是空格的单元不标记）
+ */
+void ST7567_TextGrid::clearRow(uint8_t row)
+{
+    for (uint8_t col = 0; col < COLUMNS; col++)
+    {
+        setCell(col, row, ' ', ATTR_NORMAL);
+    }
+}
+
+/**
+ * @brief 设置单元，内容不变时不标记
+ */
+void ST7567_TextGrid::setCell(uint8_t col, uint8_t row, char c, uint8_t attr)
+{
+    if (col >= COLUMNS || row >= ROWS)
+        return;
+
+    if (_chars[row][col] != c || _attrs[row][col] != attr)
+    {
+        _chars[row][col] = c;
+        _attrs[row][col] = attr;
+        _dirty[row] |= 1UL << col;
+    }
+}
+
+/**
+ * @brief 读取单元字符
+ */
+char ST7567_TextGrid::getChar(uint8_t col, uint8_t row) const
+{
+    return (col < COLUMNS && row < ROWS) ? _chars[row][col] : ' ';
+}
+
+/**
+ * @brief 读取单元属性
+ */
+uint8_t ST7567_TextGrid::getAttr(uint8_t col, uint8_t row) const
+{
+    return (col < COLUMNS && row < ROWS) ? _attrs[row][col] : ATTR_NORMAL;
+}
+
+/**
+ * @brief 在指定位置写入字符串
+ * @return 写入的字符数
+ */
+size_t ST7567_TextGrid::printAt(uint8_t col, uint8_t row, const char *text)
+{
+    size_t n = 0;
+    while (*text != '\0' && col < COLUMNS)
+    {
+        setCell(col++, row, *text++, _attr);
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief 设置光标
+ */
+void ST7567_TextGrid::setCursor(uint8_t col, uint8_t row)
+{
+    _cursorCol = col;
+    _cursorRow = row;
+}
+
+/**
+ * @brief 写入一个字符
+ *
+ * 不自动换行也不滚动：状态界面中字段位置固定，超出行尾的字符被丢弃
+ */
+size_t ST7567_TextGrid::write(uint8_t c)
+{
+    if (c == '\n')
+    {
+        _cursorCol = 0;
+        _cursorRow++;
+        return 1;
+    }
+    if (c == '\r')
+    {
+        _cursorCol = 0;
+        return 1;
+    }
+    if (_cursorCol >= COLUMNS || _cursorRow >= ROWS)
+        return 0;
+
+    setCell(_cursorCol++, _cursorRow, (char)c, _attr);
+    return 1;
+}
+
+/**
+ * @brief 标记全部单元
+ */
+void ST7567_TextGrid::invalidate()
+{
+    for (uint8_t row = 0; row < ROWS; row++)
+    {
+        _dirty[row] = ALL_COLUMNS;
+    }
+}
+
+/**
+ * @brief 光栅化一个单元
+ *
+ * 单元页对齐，drawGlyph5x7()走整字节写入路径（反色时逐列混合），并登记该单元的脏列；
+ * 下划线为单元最下面一行（bit7）
+ */
+void ST7567_TextGrid::renderCell(uint8_t col, uint8_t row)
+{
+    uint8_t c = (uint8_t)_chars[row][col];
+    uint8_t attr = _attrs[row][col];
+    bool inverse = attr & ATTR_INVERSE;
+
+    // 与Adafruit_GFX::drawChar()相同的cp437兼容修正
+    if (!_lcd._cp437 && c >= 176)
+        c++;
+
+    int16_t x = col * CELL_WIDTH;
+    _lcd.drawGlyph5x7(x, row * 8, c, inverse ? ST7567_BLACK : ST7567_WHITE,
+                      inverse ? ST7567_WHITE : ST7567_BLACK);
+
+    if (attr & ATTR_UNDERLINE)
+    {
+        st7567_applyMaskSpan(&_lcd.getFrameBuffer()[row * ST7567_LCD::LCD_WIDTH + x], CELL_WIDTH, 0x80,
+                             inverse ? ST7567_BLACK : ST7567_WHITE);
+    }
+}
+
+/**
+ * @brief 渲染变化的单元
+ * @param flush 渲染后是否立即发送
+ * @return 渲染的单元数
+ */
+uint8_t ST7567_TextGrid::update(bool flush)
+{
+    if (_lcd.isPageMode())
+        return 0;
+
+    uint8_t count = 0;
+    for (uint8_t row = 0; row < ROWS; row++)
+    {
+        uint32_t bits = _dirty[row];
+        if (bits == 0)
+            continue;
+
+        for (uint8_t col = 0; col < COLUMNS; col++)
+        {
+            if (bits & (1UL << col))
+            {
+                renderCell(col, row);
+                count++;
+            }
+        }
+        _dirty[row] = 0;
+    }
+
+    if (flush && count > 0)
+    {
+        _lcd.displayDirty();
+    }
+    return count;
+}
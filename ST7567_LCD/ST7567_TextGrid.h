@@ -0,0 +1,152 @@
+/**
+ * @file ST7567_TextGrid.h
+ * @brief ST7567 字符网格（状态界面增量文本渲染）
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 把屏幕划分为21列 × 8行的字符单元（5x7字体，每格6x8像素，页对齐）：
+ * - 应用把字符串写入单元数组，写入时逐格比较，只有字符或属性变化的单元被标记
+ * - update()只重新光栅化被标记的单元（每格6字节直接写入帧缓冲区）并登记脏区
+ * - 刷新走displayDirty()，只发送变化单元所在的列区间
+ *
+ * 静态界面上每100ms变化几个数字时，每帧只需渲染和发送几个单元，
+ * 而不是用print()重绘整串文字再整帧刷新。
+ *
+ * 使用示例：
+ * @code
+ * ST7567_TextGrid grid(lcd);
+ *
+ * void setup() {
+ *     lcd.begin();
+ *     grid.begin();
+ *     grid.printAt(0, 0, "Voltage:");
+ *     grid.printAt(0, 1, "Current:");
+ * }
+ *
+ * void loop() {
+ *     grid.setCursor(9, 0);
+ *     grid.printf("%5.2fV", readVoltage()); // 数值不变的字符不会重绘
+ *     grid.update();
+ * }
+ * @endcode
+ *
+ * @note 网格独占帧缓冲区的0~125列；用其他绘图函数覆盖了网格区域后调用invalidate()。
+ * 仅支持旋转0，分页渲染模式下不可用
+ */
+
+#ifndef __ST7567_TEXT_GRID_H
+#define __ST7567_TEXT_GRID_H
+
+#include "ST7567_LCD.h"
+
+class ST7567_TextGrid : public Print
+{
+public:
+    static const uint8_t CELL_WIDTH = 6;                                 ///< 单元宽度（5列字形+1列间隔）
+    static const uint8_t COLUMNS = ST7567_LCD::LCD_WIDTH / CELL_WIDTH;   ///< 列数（21）
+    static const uint8_t ROWS = ST7567_LCD::PAGE_COUNT;                  ///< 行数（每页一行，共8行）
+
+    static const uint8_t ATTR_NORMAL = 0x00;    ///< 白字黑底
+    static const uint8_t ATTR_INVERSE = 0x01;   ///< 反色（黑字白底）
+    static const uint8_t ATTR_UNDERLINE = 0x02; ///< 下划线（单元最下面一行）
+
+    /**
+     * @brief 构造函数
+     * @param lcd 显示屏驱动
+     */
+    ST7567_TextGrid(ST7567_LCD &lcd);
+
+    /**
+     * @brief 清空网格并标记全部单元（下次update()时覆盖网格区域）
+     */
+    void begin();
+
+    /**
+     * @brief 所有单元填充空格
+     */
+    void clear();
+
+    /**
+     * @brief 一行填充空格
+     * @param row 行号
+     */
+    void clearRow(uint8_t row);
+
+    /**
+     * @brief 设置单元
+     * @param col 列号
+     * @param row 行号
+     * @param c 字符
+     * @param attr 属性（ATTR_*组合）
+     */
+    void setCell(uint8_t col, uint8_t row, char c, uint8_t attr = ATTR_NORMAL);
+
+    /**
+     * @brief 读取单元字符
+     */
+    char getChar(uint8_t col, uint8_t row) const;
+
+    /**
+     * @brief 读取单元属性
+     */
+    uint8_t getAttr(uint8_t col, uint8_t row) const;
+
+    /**
+     * @brief 在指定位置写入字符串（使用当前属性，超出行尾的部分被截断）
+     * @param col 起始列
+     * @param row 行号
+     * @param text 字符串
+     * @return 写入的字符数
+     */
+    size_t printAt(uint8_t col, uint8_t row, const char *text);
+
+    /**
+     * @brief 设置光标（print()/printf()的写入位置）
+     * @param col 列号
+     * @param row 行号
+     */
+    void setCursor(uint8_t col, uint8_t row);
+
+    /**
+     * @brief 设置后续写入使用的属性
+     * @param attr 属性（ATTR_*组合）
+     */
+    void setAttr(uint8_t attr) { _attr = attr; }
+
+    /**
+     * @brief 写入一个字符
+     * @param c 字符（'\n'换到下一行行首，'\r'回到行首）
+     * @return 写入行内时为1，超出网格时为0
+     */
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    /**
+     * @brief 标记全部单元需要重新渲染
+     */
+    void invalidate();
+
+    /**
+     * @brief 渲染变化的单元
+     * @param flush true:渲染后调用displayDirty()发送
+     * @return 本次渲染的单元数
+     */
+    uint8_t update(bool flush = true);
+
+private:
+    /**
+     * @brief 光栅化一个单元（直接写入帧缓冲区对应页）
+     */
+    void renderCell(uint8_t col, uint8_t row);
+
+    ST7567_LCD &_lcd;                ///< 显示屏驱动
+    char _chars[ROWS][COLUMNS];      ///< 单元字符
+    uint8_t _attrs[ROWS][COLUMNS];   ///< 单元属性
+    uint32_t _dirty[ROWS];           ///< 各行需要渲染的单元（bit n对应第n列）
+    uint8_t _cursorCol;              ///< 光标列
+    uint8_t _cursorRow;              ///< 光标行
+    uint8_t _attr;                   ///< 当前写入属性
+};
+
+#endif // __ST7567_TEXT_GRID_H
@@ -0,0 +1,77 @@
+/**
+ * @file bench_transfer.cpp
+ * @brief 整帧传输字节数基准（计数SPI模拟）
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * 统计display()和clearScreen()实际发出的字节：
+ * - 总字节数等于FULL_FRAME_BYTES（1024字节数据 + 8页 × 3字节地址命令）
+ * - 整帧只拉低一次片选，SPI库按块调用（调用次数远小于字节数）
+ * - 显示RAM与帧缓冲区一致
+ * 并按40MHz打印线路时间，与estimateTransferTime()对照
+ */
+
+#include "host_test.h"
+#include "ST7567_LCD.h"
+
+static const uint32_t BENCH_FREQUENCY = 40000000; ///< 打印时间使用的SPI时钟
+
+/**
+ * @brief 整帧SPI库调用次数上限：每页地址命令一次 + 数据按32字节分块
+ *
+ * 非ESP平台transfer()会用接收数据覆盖缓冲区，驱动经32字节栈缓冲区分块发送
+ */
+static const uint32_t MAX_SPI_CALLS = ST7567_LCD::PAGE_COUNT * (1 + ST7567_LCD::LCD_WIDTH / 32);
+
+/**
+ * @brief 打印一次传输的计数和40MHz下的线路时间
+ */
+static void report(const char *name)
+{
+    uint32_t us = ST7567_LCD::estimateTransferTime(MockBus::bytes, BENCH_FREQUENCY);
+    printf("%-14s bytes=%u (cmd=%u data=%u) cs=%u spi_calls=%u  %.1fus @40MHz (estimate %uus)\n", name,
+           MockBus::bytes, MockBus::commandBytes, MockBus::dataBytes, MockBus::csAssertions, MockBus::transfers,
+           MockBus::bytes * 8.0 * 1e6 / BENCH_FREQUENCY, us);
+}
+
+int main()
+{
+    digitalWrite(MockBus::CS_PIN, HIGH);
+
+    ST7567_LCD lcd(MockBus::CS_PIN, 4, MockBus::DC_PIN, SPI, BENCH_FREQUENCY);
+    lcd.begin();
+
+    uint8_t *fb = lcd.getFrameBuffer();
+    for (uint16_t i = 0; i < ST7567_LCD::FRAME_SIZE; i++)
+        fb[i] = (uint8_t)(i * 13 + 1);
+
+    // display()：整帧
+    MockBus::resetCounters();
+    lcd.display();
+    report("display()");
+    CHECK(MockBus::bytes == ST7567_LCD::FULL_FRAME_BYTES);
+    CHECK(MockBus::dataBytes == ST7567_LCD::FRAME_SIZE);
+    CHECK(MockBus::commandBytes == ST7567_LCD::PAGE_COUNT * ST7567_LCD::ADDR_CMD_BYTES);
+    CHECK(MockBus::csAssertions == 1);
+    CHECK(MockBus::transfers <= MAX_SPI_CALLS);
+    CHECK(!MockBus::csError);
+    CHECK(ramEquals(fb));
+
+    // clearScreen()：图案填充，字节数与整帧相同
+    MockBus::resetCounters();
+    lcd.clearScreen(0xA5);
+    report("clearScreen()");
+    CHECK(MockBus::bytes == ST7567_LCD::FULL_FRAME_BYTES);
+    CHECK(MockBus::dataBytes == ST7567_LCD::FRAME_SIZE);
+    CHECK(MockBus::csAssertions == 1);
+    CHECK(MockBus::transfers <= MAX_SPI_CALLS);
+    CHECK(!MockBus::csError);
+    CHECK(ramEquals(fb));
+    CHECK(fb[0] == 0xA5 && fb[ST7567_LCD::FRAME_SIZE - 1] == 0xA5);
+
+    // 40MHz整帧理论时间：1048字节 × 8位 / 40MHz ≈ 210us
+    CHECK(ST7567_LCD::estimateTransferTime(ST7567_LCD::FULL_FRAME_BYTES, BENCH_FREQUENCY) == 210);
+
+    return testResult("bench_transfer");
+}
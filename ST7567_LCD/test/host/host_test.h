@@ -0,0 +1,52 @@
+/**
+ * @file host_test.h
+ * @brief 主机测试公共部分：检查宏和显示RAM比较
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#ifndef __HOST_TEST_H
+#define __HOST_TEST_H
+
+#include <Arduino.h>
+#include <SPI.h>
+
+static int g_failures = 0; ///< 失败的检查数
+
+/**
+ * @brief 检查条件，失败时打印位置并计数（不中断，便于一次看到全部失败）
+ */
+#define CHECK(cond)                                                        \
+    do                                                                     \
+    {                                                                      \
+        if (!(cond))                                                       \
+        {                                                                  \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            g_failures++;                                                  \
+        }                                                                  \
+    } while (0)
+
+/**
+ * @brief 显示RAM前128列是否与页格式帧数据一致
+ */
+static inline bool ramEquals(const uint8_t *frame)
+{
+    for (uint8_t page = 0; page < 8; page++)
+    {
+        if (memcmp(MockBus::ram[page], &frame[page * 128], 128) != 0)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 测试结束：打印结果并返回进程退出码
+ */
+static inline int testResult(const char *name)
+{
+    printf("%s: %s\n", name, g_failures == 0 ? "PASS" : "FAIL");
+    return g_failures == 0 ? 0 : 1;
+}
+
+#endif // __HOST_TEST_H
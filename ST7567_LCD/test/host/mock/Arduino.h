@@ -0,0 +1,123 @@
+/**
+ * @file Arduino.h
+ * @brief 主机测试用Arduino核心模拟
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details 只提供驱动用到的部分：GPIO记录到MockBus（片选下降沿计数、DC电平），
+ * 时间由MockBus::micros驱动（delay()直接推进，不真正等待）
+ */
+
+#ifndef __MOCK_ARDUINO_H
+#define __MOCK_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define F(s) s
+#define IRAM_ATTR
+
+typedef bool boolean;
+using std::max;
+using std::min;
+
+/**
+ * @brief 模拟总线：记录GPIO和SPI字节，并按ST7567指令维护显示RAM
+ */
+struct MockBus
+{
+    static const int CS_PIN = 5; ///< 测试使用的片选引脚
+    static const int DC_PIN = 2; ///< 测试使用的数据/命令引脚
+
+    static int pins[64];          ///< 引脚电平
+    static uint8_t ram[8][132];   ///< 显示RAM（8页 × 132列）
+    static uint8_t page;          ///< 当前页地址
+    static uint8_t column;        ///< 当前列地址
+    static uint8_t startLine;     ///< 显示起始行
+    static uint32_t bytes;        ///< SPI总字节数
+    static uint32_t commandBytes; ///< 命令字节数（DC低）
+    static uint32_t dataBytes;    ///< 显示数据字节数（DC高）
+    static uint32_t csAssertions; ///< 片选拉低次数
+    static uint32_t transfers;    ///< SPI库调用次数
+    static uint32_t micros;       ///< 模拟时钟（微秒）
+    static bool csError;          ///< 片选无效时收到过字节
+
+    /**
+     * @brief 清零计数（引脚和显示RAM保留）
+     */
+    static void resetCounters();
+
+    /**
+     * @brief 总线上出现一个字节
+     */
+    static void byte(uint8_t b);
+};
+
+inline void pinMode(int, int) {}
+inline int digitalRead(int pin) { return MockBus::pins[pin & 63]; }
+inline void digitalWrite(int pin, int value)
+{
+    if (pin < 0 || pin >= 64)
+        return;
+    if (pin == MockBus::CS_PIN && value == LOW && MockBus::pins[pin] != LOW)
+        MockBus::csAssertions++;
+    MockBus::pins[pin] = value;
+}
+inline void shiftOut(int, int, int, uint8_t b) { MockBus::byte(b); }
+inline uint32_t micros() { return MockBus::micros; }
+inline uint32_t millis() { return MockBus::micros / 1000; }
+inline void delay(uint32_t ms) { MockBus::micros += ms * 1000; }
+inline void delayMicroseconds(uint32_t us) { MockBus::micros += us; }
+inline void yield() {}
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t n = 0;
+        while (size--)
+            n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+    size_t print(const char *s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(long value, int base = 10) { return printf(base == 16 ? "%lx" : "%ld", value); }
+    size_t print(unsigned long value, int base = 10) { return printf(base == 16 ? "%lx" : "%lu", value); }
+    size_t print(int value, int base = 10) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = 10) { return print((unsigned long)value, base); }
+    size_t print(double value, int digits = 2) { return printf("%.*f", digits, value); }
+    size_t println(const char *s) { return print(s) + println(); }
+    size_t println() { return write("\r\n"); }
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class HardwareSerial : public Print
+{
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#endif // __MOCK_ARDUINO_H
@@ -0,0 +1,86 @@
+/**
+ * @file MockFlushEngine.h
+ * @brief 主机测试用异步刷新引擎：记录分段，由测试决定何时"传输完成"
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * @details submit()只复制分段描述并进入忙状态；complete()（或wait()）把分段按顺序
+ * 送入MockBus（整个提交一次片选，按分段类型设置DC），然后退出忙状态并调用完成回调，
+ * 相当于DMA完成中断
+ */
+
+#ifndef __MOCK_FLUSH_ENGINE_H
+#define __MOCK_FLUSH_ENGINE_H
+
+#include "ST7567_FlushEngine.h"
+
+class MockFlushEngine : public ST7567_FlushEngine
+{
+public:
+    static const uint8_t MAX_SEGMENTS = 32; ///< 一次提交的最大分段数
+
+    MockFlushEngine() : count(0), busy(false), begun(false), submits(0), completions(0), rejects(0) {}
+
+    bool begin() override
+    {
+        begun = true;
+        return true;
+    }
+
+    bool submit(const ST7567_FlushSegment *list, uint8_t n) override
+    {
+        if (busy || n > MAX_SEGMENTS)
+        {
+            rejects++;
+            return false;
+        }
+        memcpy(segments, list, n * sizeof(ST7567_FlushSegment));
+        count = n;
+        busy = true;
+        submits++;
+        return true;
+    }
+
+    bool isBusy() override { return busy; }
+
+    void wait() override { complete(); }
+
+    void writeBlocking(const uint8_t *data, size_t len) override
+    {
+        for (size_t i = 0; i < len; i++)
+            MockBus::byte(data[i]);
+    }
+
+    /**
+     * @brief 发送已提交的分段并通知完成
+     */
+    void complete()
+    {
+        if (!busy)
+            return;
+
+        digitalWrite(MockBus::CS_PIN, LOW);
+        for (uint8_t i = 0; i < count; i++)
+        {
+            digitalWrite(MockBus::DC_PIN, segments[i].isData ? HIGH : LOW);
+            for (uint16_t j = 0; j < segments[i].length; j++)
+                MockBus::byte(segments[i].data[j]);
+        }
+        digitalWrite(MockBus::CS_PIN, HIGH);
+
+        busy = false;
+        completions++;
+        notifyComplete();
+    }
+
+    ST7567_FlushSegment segments[MAX_SEGMENTS]; ///< 最近一次提交的分段
+    uint8_t count;        ///< 分段数
+    bool busy;            ///< 有未完成的提交
+    bool begun;           ///< begin()已被调用
+    uint32_t submits;     ///< 接受的提交次数
+    uint32_t completions; ///< 完成次数
+    uint32_t rejects;     ///< 拒绝的提交次数
+};
+
+#endif // __MOCK_FLUSH_ENGINE_H
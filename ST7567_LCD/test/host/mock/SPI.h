@@ -0,0 +1,60 @@
+/**
+ * @file SPI.h
+ * @brief 主机测试用SPI库模拟（字节送入MockBus）
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#ifndef __MOCK_SPI_H
+#define __MOCK_SPI_H
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0
+
+class SPISettings
+{
+public:
+    SPISettings() {}
+    SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass
+{
+public:
+    void begin() {}
+    void beginTransaction(SPISettings) {}
+    void endTransaction() {}
+
+    uint8_t transfer(uint8_t b)
+    {
+        MockBus::transfers++;
+        MockBus::byte(b);
+        return 0;
+    }
+
+    void transfer(void *buffer, size_t size)
+    {
+        writeBytes((const uint8_t *)buffer, size);
+    }
+
+    void writeBytes(const uint8_t *data, uint32_t size)
+    {
+        MockBus::transfers++;
+        for (uint32_t i = 0; i < size; i++)
+            MockBus::byte(data[i]);
+    }
+
+    void writePattern(const uint8_t *data, uint8_t size, uint32_t repeat)
+    {
+        MockBus::transfers++;
+        for (uint32_t r = 0; r < repeat; r++)
+            for (uint8_t i = 0; i < size; i++)
+                MockBus::byte(data[i]);
+    }
+};
+
+extern SPIClass SPI;
+
+#endif // __MOCK_SPI_H
@@ -0,0 +1,11 @@
+/**
+ * @file glcdfont.c
+ * @brief 主机测试用5x7字体占位（总线测试不关心字形内容）
+ */
+
+#ifndef FONT5X7_H
+#define FONT5X7_H
+
+static const unsigned char font[256 * 5] PROGMEM = {0};
+
+#endif // FONT5X7_H
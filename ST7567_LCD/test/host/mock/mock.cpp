@@ -0,0 +1,298 @@
+/**
+ * @file mock.cpp
+ * @brief 主机测试模拟实现：总线状态、串口、Adafruit_GFX基类
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Adafruit_GFX.h>
+#include <stdarg.h>
+
+int MockBus::pins[64];
+uint8_t MockBus::ram[8][132];
+uint8_t MockBus::page;
+uint8_t MockBus::column;
+uint8_t MockBus::startLine;
+uint32_t MockBus::bytes;
+uint32_t MockBus::commandBytes;
+uint32_t MockBus::dataBytes;
+uint32_t MockBus::csAssertions;
+uint32_t MockBus::transfers;
+uint32_t MockBus::micros;
+bool MockBus::csError;
+
+HardwareSerial Serial;
+SPIClass SPI;
+
+void MockBus::resetCounters()
+{
+    bytes = 0;
+    commandBytes = 0;
+    dataBytes = 0;
+    csAssertions = 0;
+    transfers = 0;
+    csError = false;
+}
+
+/**
+ * @brief 总线上出现一个字节
+ *
+ * DC低时解码页地址、列地址和起始行命令（双字节命令跳过参数），
+ * DC高时写入显示RAM并使列地址自增
+ */
+void MockBus::byte(uint8_t b)
+{
+    static bool parameter = false;
+
+    bytes++;
+    if (pins[CS_PIN] != LOW)
+        csError = true;
+
+    if (pins[DC_PIN] == LOW)
+    {
+        commandBytes++;
+        if (parameter)
+        {
+            parameter = false;
+        }
+        else if ((b & 0xF0) == 0xB0)
+        {
+            page = b & 0x0F;
+        }
+        else if ((b & 0xF0) == 0x10)
+        {
+            column = (column & 0x0F) | ((b & 0x0F) << 4);
+        }
+        else if ((b & 0xF0) == 0x00)
+        {
+            column = (column & 0xF0) | (b & 0x0F);
+        }
+        else if ((b & 0xC0) == 0x40)
+        {
+            startLine = b & 0x3F;
+        }
+        else if (b == 0x81 || b == 0xF8 || b == 0xAC)
+        {
+            parameter = true;
+        }
+        return;
+    }
+
+    dataBytes++;
+    if (page < 8 && column < 132)
+        ram[page][column] = b;
+    if (column < 132)
+        column++;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    return write(buffer);
+}
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h)
+    : WIDTH(w), HEIGHT(h), _width(w), _height(h), cursor_x(0), cursor_y(0), textcolor(0xFFFF),
+      textbgcolor(0xFFFF), textsize_x(1), textsize_y(1), rotation(0), wrap(true), _cp437(false),
+      gfxFont(nullptr)
+{
+}
+
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep)
+    {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1)
+    {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    int16_t dx = x1 - x0;
+    int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+    for (; x0 <= x1; x0++)
+    {
+        if (steep)
+            writePixel(y0, x0, color);
+        else
+            writePixel(x0, y0, color);
+        err -= dy;
+        if (err < 0)
+        {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+void Adafruit_GFX::setRotation(uint8_t r)
+{
+    rotation = r & 3;
+    _width = (rotation & 1) ? HEIGHT : WIDTH;
+    _height = (rotation & 1) ? WIDTH : HEIGHT;
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    for (int16_t i = 0; i < h; i++)
+        writePixel(x, y + i, color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    for (int16_t i = 0; i < w; i++)
+        writePixel(x + i, y, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    for (int16_t i = 0; i < w; i++)
+        writeFastVLine(x + i, y, h, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    writeLine(x0, y0, x1, y1, color);
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    writeFastHLine(x, y, w, color);
+    writeFastHLine(x, y + h - 1, w, color);
+    writeFastVLine(x, y, h, color);
+    writeFastVLine(x + w - 1, y, h, color);
+}
+
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+    for (int16_t y = -r; y <= r; y++)
+        for (int16_t x = -r; x <= r; x++)
+            if (x * x + y * y <= r * r && x * x + y * y > (r - 1) * (r - 1))
+                writePixel(x0 + x, y0 + y, color);
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+    for (int16_t y = -r; y <= r; y++)
+        for (int16_t x = -r; x <= r; x++)
+            if (x * x + y * y <= r * r)
+                writePixel(x0 + x, y0 + y, color);
+}
+
+void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                                uint16_t color)
+{
+    writeLine(x0, y0, x1, y1, color);
+    writeLine(x1, y1, x2, y2, color);
+    writeLine(x2, y2, x0, y0, color);
+}
+
+void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t, uint16_t color)
+{
+    fillRect(x, y, w, h, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+{
+    int16_t stride = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++)
+        for (int16_t i = 0; i < w; i++)
+            if (bitmap[j * stride + i / 8] & (0x80 >> (i & 7)))
+                writePixel(x + i, y + j, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color,
+                              uint16_t bg)
+{
+    int16_t stride = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++)
+        for (int16_t i = 0; i < w; i++)
+            writePixel(x + i, y + j, (bitmap[j * stride + i / 8] & (0x80 >> (i & 7))) ? color : bg);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
+{
+    drawBitmap(x, y, (const uint8_t *)bitmap, w, h, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color,
+                              uint16_t bg)
+{
+    drawBitmap(x, y, (const uint8_t *)bitmap, w, h, color, bg);
+}
+
+void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+{
+    int16_t stride = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++)
+        for (int16_t i = 0; i < w; i++)
+            if (bitmap[j * stride + i / 8] & (1 << (i & 7)))
+                writePixel(x + i, y + j, color);
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size)
+{
+    drawChar(x, y, c, color, bg, size, size);
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char, uint16_t color, uint16_t bg, uint8_t size_x,
+                            uint8_t size_y)
+{
+    if (bg != color)
+        writeFillRect(x, y, 6 * size_x, 8 * size_y, bg);
+}
+
+size_t Adafruit_GFX::write(uint8_t c)
+{
+    if (c == '\n')
+    {
+        cursor_x = 0;
+        cursor_y += textsize_y * 8;
+    }
+    else if (c != '\r')
+    {
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+        cursor_x += textsize_x * 6;
+    }
+    return 1;
+}
+
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h)
+{
+    buffer = (uint8_t *)calloc(((w + 7) / 8) * h, 1);
+}
+
+GFXcanvas1::~GFXcanvas1()
+{
+    free(buffer);
+}
+
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+        return;
+    uint8_t *p = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+    if (color)
+        *p |= 0x80 >> (x & 7);
+    else
+        *p &= ~(0x80 >> (x & 7));
+}
+
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const
+{
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+        return false;
+    return buffer[(x / 8) + y * ((WIDTH + 7) / 8)] & (0x80 >> (x & 7));
+}
@@ -0,0 +1,91 @@
+/**
+ * @file test_flush_engine.cpp
+ * @brief displayAsync()的分段时序测试（模拟总线）
+ * @version 1.0
+ * @date 2025-11-7
+ * @author 航海家-Navigator
+ *
+ * 验证内容：
+ * - 一次提交为8页 × (3字节地址命令 + 128字节数据) 共16个分段
+ * - 提交后忙，完成前不调用回调；完成后空闲，回调恰好调用一次
+ * - 发送的是提交时的快照，忙期间继续绘制不影响本帧
+ * - 引擎忙时再次displayAsync()先等待上一帧完成
+ */
+
+#include "host_test.h"
+#include "ST7567_LCD.h"
+#include "MockFlushEngine.h"
+
+static uint32_t g_callbacks = 0;
+
+static void onFlushComplete(void *context)
+{
+    g_callbacks++;
+    CHECK(context == &g_callbacks);
+}
+
+int main()
+{
+    digitalWrite(MockBus::CS_PIN, HIGH);
+
+    MockFlushEngine engine;
+    ST7567_LCD lcd(MockBus::CS_PIN, 4, MockBus::DC_PIN);
+    lcd.setFlushEngine(&engine);
+    lcd.setFlushCallback(onFlushComplete, &g_callbacks);
+    lcd.begin();
+    CHECK(engine.begun);
+    CHECK(!lcd.isFlushBusy());
+
+    uint8_t *fb = lcd.getFrameBuffer();
+    for (uint16_t i = 0; i < ST7567_LCD::FRAME_SIZE; i++)
+        fb[i] = (uint8_t)(i * 7 + 3);
+    uint8_t snapshot[ST7567_LCD::FRAME_SIZE];
+    memcpy(snapshot, fb, sizeof(snapshot));
+
+    // 提交：16个分段，命令/数据交替
+    MockBus::resetCounters();
+    CHECK(lcd.displayAsync());
+    CHECK(MockBus::bytes == 0); // 数据由引擎在后台发送
+    CHECK(engine.count == ST7567_LCD::PAGE_COUNT * 2);
+    for (uint8_t page = 0; page < ST7567_LCD::PAGE_COUNT; page++)
+    {
+        const ST7567_FlushSegment &cmd = engine.segments[page * 2];
+        const ST7567_FlushSegment &data = engine.segments[page * 2 + 1];
+        CHECK(!cmd.isData);
+        CHECK(cmd.length == ST7567_LCD::ADDR_CMD_BYTES);
+        CHECK(cmd.data[0] == 0xB0 + page);
+        CHECK(cmd.data[1] == 0x10);
+        CHECK(cmd.data[2] == 0x00);
+        CHECK(data.isData);
+        CHECK(data.length == ST7567_LCD::LCD_WIDTH);
+        CHECK(memcmp(data.data, &snapshot[page * ST7567_LCD::LCD_WIDTH], ST7567_LCD::LCD_WIDTH) == 0);
+    }
+
+    // 忙 → 完成
+    CHECK(lcd.isFlushBusy());
+    CHECK(g_callbacks == 0);
+    lcd.fillScreen(ST7567_BLACK); // 忙期间绘制下一帧
+    engine.complete();
+    CHECK(!lcd.isFlushBusy());
+    CHECK(g_callbacks == 1);
+    CHECK(ramEquals(snapshot));
+    CHECK(MockBus::csAssertions == 1);
+    CHECK(MockBus::dataBytes == ST7567_LCD::FRAME_SIZE);
+    CHECK(MockBus::commandBytes == ST7567_LCD::PAGE_COUNT * ST7567_LCD::ADDR_CMD_BYTES);
+    CHECK(!MockBus::csError);
+
+    // 忙时再次提交：先等待上一帧完成，再提交新的快照
+    CHECK(lcd.displayAsync());
+    CHECK(engine.submits == 2);
+    fb[0] = 0xFF;
+    CHECK(lcd.displayAsync());
+    CHECK(engine.completions == 2);
+    CHECK(engine.submits == 3);
+    CHECK(engine.rejects == 0);
+    CHECK(g_callbacks == 2);
+    lcd.waitFlush();
+    CHECK(g_callbacks == 3);
+    CHECK(ramEquals(fb));
+
+    return testResult("test_flush_engine");
+}
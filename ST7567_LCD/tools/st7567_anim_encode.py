@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""
+ST7567 动画编码工具
+把GIF动画或图片序列转换为ST7567_AnimPlayer播放的增量压缩动画文件（.anim）
+
+每帧与上一帧逐页异或，只保存有变化的页；页内128列编码为跳过段和增量段：
+  0x00-0x7F  跳过 n+1 列
+  0x80-0xFF  后跟 n-0x7F 个增量字节
+格式说明见 ST7567_Animation.h
+
+用法：
+  python3 st7567_anim_encode.py boot.gif -o boot.anim
+  python3 st7567_anim_encode.py frames/*.png -o idle.anim --delay 50 --invert
+"""
+
+import argparse
+import struct
+import sys
+
+from PIL import Image, ImageSequence
+
+WIDTH = 128
+HEIGHT = 64
+PAGES = HEIGHT // 8
+FRAME_SIZE = WIDTH * PAGES
+HEADER_SIZE = 16
+VERSION = 1
+
+
+def image_to_frame(img, threshold=128, invert=False):
+    """
+    将图像转换为页格式帧（8页 × 128字节，bit0在上）
+    """
+    img = img.convert('L')
+    if img.size != (WIDTH, HEIGHT):
+        img = img.resize((WIDTH, HEIGHT))
+    pixels = img.load()
+
+    frame = bytearray(FRAME_SIZE)
+    for page in range(PAGES):
+        for x in range(WIDTH):
+            value = 0
+            for bit in range(8):
+                on = pixels[x, page * 8 + bit] >= threshold
+                if on != invert:
+                    value |= 1 << bit
+            frame[page * WIDTH + x] = value
+    return frame
+
+
+def load_frames(paths, threshold, invert, default_delay):
+    """
+    读取输入文件，返回 [(帧数据, 显示时间ms)]；GIF使用文件中的帧时间
+    """
+    frames = []
+    for path in paths:
+        img = Image.open(path)
+        for frame in ImageSequence.Iterator(img):
+            delay = frame.info.get('duration', default_delay) or default_delay
+            frames.append((image_to_frame(frame, threshold, invert), int(delay)))
+    return frames
+
+
+def encode_page(delta):
+    """
+    编码一页的增量（128字节）
+
+    长度为1的零段并入前后的增量段（跳过1列和切换段各需1字节，合并后不增加长度）
+    """
+    out = bytearray()
+    x = 0
+    while x < WIDTH:
+        if delta[x] == 0:
+            run = 1
+            while x + run < WIDTH and delta[x + run] == 0 and run < 128:
+                run += 1
+            out.append(run - 1)
+            x += run
+            continue
+
+        start = x
+        while x < WIDTH and x - start < 128:
+            if delta[x] == 0 and (x + 1 >= WIDTH or delta[x + 1] == 0):
+                break
+            x += 1
+        out.append(0x7F + (x - start))
+        out += delta[start:x]
+    return out
+
+
+def encode_frame(prev, cur, delay):
+    """
+    编码一帧（相对上一帧的增量）
+    """
+    mask = 0
+    body = bytearray()
+    for page in range(PAGES):
+        offset = page * WIDTH
+        delta = bytes(a ^ b for a, b in zip(prev[offset:offset + WIDTH], cur[offset:offset + WIDTH]))
+        if any(delta):
+            mask |= 1 << page
+            body += encode_page(delta)
+    return struct.pack('<HB', min(delay, 0xFFFF), mask) + body
+
+
+def encode_animation(frames, loop=True):
+    """
+    生成完整文件；循环时末尾附加从最后一帧回到第0帧的循环帧
+    """
+    records = []
+    prev = bytearray(FRAME_SIZE)
+    for data, delay in frames:
+        records.append(encode_frame(prev, data, delay))
+        prev = data
+
+    loop_offset = 0
+    if loop:
+        loop_offset = HEADER_SIZE + len(records[0])
+        records.append(encode_frame(prev, frames[0][0], frames[0][1]))
+
+    header = b'S7AN' + struct.pack('<BBHHHI', VERSION, PAGES, WIDTH, len(frames), 0, loop_offset)
+    return header + b''.join(records), records
+
+
+def main():
+    parser = argparse.ArgumentParser(description='ST7567 增量压缩动画编码工具')
+    parser.add_argument('inputs', nargs='+', help='GIF动画或图片序列（按给出的顺序）')
+    parser.add_argument('-o', '--output', required=True, help='输出.anim文件')
+    parser.add_argument('--delay', type=int, default=100, help='没有帧时间时的显示时间（毫秒）')
+    parser.add_argument('--threshold', type=int, default=128, help='二值化阈值')
+    parser.add_argument('--invert', action='store_true', help='暗像素点亮')
+    parser.add_argument('--no-loop', action='store_true', help='不生成循环帧')
+    args = parser.parse_args()
+
+    frames = load_frames(args.inputs, args.threshold, args.invert, args.delay)
+    if not frames:
+        print('没有读取到帧')
+        return 1
+    if len(frames) > 0xFFFF:
+        print('帧数超过65535')
+        return 1
+
+    data, records = encode_animation(frames, not args.no_loop)
+    with open(args.output, 'wb') as f:
+        f.write(data)
+
+    raw = len(frames) * FRAME_SIZE
+    deltas = records[1:len(frames)]
+    print(f'帧数: {len(frames)}')
+    print(f'文件大小: {len(data)} 字节（原始 {raw} 字节，压缩比 {raw / len(data):.1f}x）')
+    if deltas:
+        average = sum(len(r) for r in deltas) / len(deltas)
+        print(f'增量帧平均: {average:.1f} 字节')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())